@@ -1,15 +1,57 @@
 using System.Collections.ObjectModel;
+using System.Runtime.CompilerServices;
+using System.Runtime.ExceptionServices;
 
 namespace TerminalForms;
 
+/// <summary>
+/// Specifies the conditions <see cref="Application.WatchFileDescriptor"/> reports for a file descriptor.
+/// </summary>
+[Flags]
+public enum FileDescriptorEvents
+{
+    /// <summary>
+    /// No conditions.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// The file descriptor can be read without blocking, or has reached the end of its data.
+    /// </summary>
+    Read = 1,
+
+    /// <summary>
+    /// The file descriptor can be written without blocking.
+    /// </summary>
+    Write = 2,
+
+    /// <summary>
+    /// The file descriptor has an error, or the other end hung up. This is reported whether or not it was asked
+    /// for.
+    /// </summary>
+    Error = 4,
+}
+
 /// <summary>
 /// Provides static methods for managing the Terminal Forms application lifecycle.
 /// </summary>
-public static partial class Application
+public static unsafe partial class Application
 {
     private static readonly List<Form> _openForms = [];
+    private static readonly Dictionary<
+        int,
+        Action<int, FileDescriptorEvents>
+    > _fileDescriptorWatches = [];
+    private static int _uiThreadId;
     private static ReadOnlyCollection<Form>? _openFormsReadOnly;
 
+    static Application()
+    {
+        // The thread that first uses the application is taken to be the UI thread, so that Invoke() works on it
+        // while forms are set up, before Run() starts the event loop. Run() then makes its own thread the UI thread.
+        _uiThreadId = Environment.CurrentManagedThreadId;
+    }
+
     /// <summary>
     /// Gets a collection of open forms owned by the application.
     /// </summary>
@@ -68,6 +110,7 @@ public static partial class Application
     /// </remarks>
     public static void Run()
     {
+        _uiThreadId = Environment.CurrentManagedThreadId;
         Check(NativeMethods.TfApplicationStaticRun());
     }
 
@@ -95,8 +138,354 @@ public static partial class Application
         Check(NativeMethods.TfApplicationStaticEnableDebugEvents(inputFile));
     }
 
+    /// <summary>
+    /// Gets or sets a value indicating whether changes to controls are drawn once per frame rather than at once.
+    /// </summary>
+    /// <value>
+    /// <see langword="true"/> to defer drawing to the next frame; otherwise, <see langword="false"/>. The default is
+    /// <see langword="false"/>.
+    /// </value>
+    /// <remarks>
+    /// <para>
+    /// Normally, every property change that affects how a control looks, such as setting <see cref="Label.Text"/>,
+    /// draws the control straight away. A handler that updates 40 controls draws 40 times, and one that sets the
+    /// same property repeatedly draws each time.
+    /// </para>
+    /// <para>
+    /// With deferred drawing, property changes only mark their control for redrawing. The event loop then draws
+    /// each marked control once and flushes the screen, at most <see cref="MaxFrameRate"/> times a second. Call
+    /// <see cref="FlushFrame"/> to draw at once, for example before a long operation on the UI thread.
+    /// Turning deferred drawing off draws anything still waiting.
+    /// </para>
+    /// </remarks>
+    public static bool DeferredDrawing
+    {
+        get
+        {
+            Check(NativeMethods.TfApplicationStaticGetDeferredDrawing(out var value));
+            return value;
+        }
+        set { Check(NativeMethods.TfApplicationStaticSetDeferredDrawing(value)); }
+    }
+
+    /// <summary>
+    /// Gets or sets the most frames per second drawn when <see cref="DeferredDrawing"/> is on.
+    /// </summary>
+    /// <value>
+    /// The frame rate cap, from 0 to 1000. The default is 60. 0 removes the cap, so a frame is drawn on every pass
+    /// of the event loop that has something to draw.
+    /// </value>
+    /// <exception cref="ArgumentOutOfRangeException">The value is less than 0 or greater than 1000.</exception>
+    public static int MaxFrameRate
+    {
+        get
+        {
+            Check(NativeMethods.TfApplicationStaticGetMaxFrameRate(out var value));
+            return value;
+        }
+        set
+        {
+            ArgumentOutOfRangeException.ThrowIfNegative(value);
+            ArgumentOutOfRangeException.ThrowIfGreaterThan(value, 1000);
+            Check(NativeMethods.TfApplicationStaticSetMaxFrameRate(value));
+        }
+    }
+
+    /// <summary>
+    /// Draws the controls waiting for the next frame and flushes the screen, without waiting for the frame.
+    /// </summary>
+    /// <remarks>
+    /// The frame is drawn even if <see cref="MaxFrameRate"/> would not allow one yet. Does nothing but flush the
+    /// screen if nothing is waiting to be drawn.
+    /// </remarks>
+    public static void FlushFrame()
+    {
+        Check(NativeMethods.TfApplicationStaticFlushFrame());
+    }
+
+    /// <summary>
+    /// Gets the number of frames drawn, redraws requested, and redraws done since the application started.
+    /// </summary>
+    /// <returns>A <see cref="FrameCounters"/> with the current counts.</returns>
+    /// <remarks>
+    /// Comparing <see cref="FrameCounters.Invalidations"/> with <see cref="FrameCounters.Draws"/> shows how many
+    /// redundant redraws <see cref="DeferredDrawing"/> saves.
+    /// </remarks>
+    public static FrameCounters GetFrameCounters()
+    {
+        Check(
+            NativeMethods.TfApplicationStaticGetFrameCounters(
+                out var frames,
+                out var invalidations,
+                out var draws
+            )
+        );
+        return new(frames, invalidations, draws);
+    }
+
+    /// <summary>
+    /// Gets or sets how far, in milliseconds, a <see cref="Timer"/> may tick late so that it can share a wake-up
+    /// with other timers.
+    /// </summary>
+    /// <value>The slack in milliseconds. The default is 10; 1 makes timers tick exactly on time.</value>
+    /// <exception cref="ArgumentOutOfRangeException">The value is less than 1.</exception>
+    /// <remarks>
+    /// Timers are due at multiples of the slack, so timers that fall due within the same span of that length tick
+    /// in one batch on one wake-up of the event loop. A larger slack means fewer wake-ups when many timers run.
+    /// The change applies to timers as they are next started or next tick.
+    /// </remarks>
+    public static int TimerSlack
+    {
+        get
+        {
+            Check(NativeMethods.TfApplicationStaticGetTimerSlack(out var value));
+            return value;
+        }
+        set
+        {
+            ArgumentOutOfRangeException.ThrowIfLessThan(value, 1);
+            Check(NativeMethods.TfApplicationStaticSetTimerSlack(value));
+        }
+    }
+
+    /// <summary>
+    /// Calls a method on the UI thread whenever the specified file descriptor is ready.
+    /// </summary>
+    /// <param name="fd">The file descriptor to watch, such as a pipe, socket or terminal.</param>
+    /// <param name="events">
+    /// The conditions to watch for: <see cref="FileDescriptorEvents.Read"/>,
+    /// <see cref="FileDescriptorEvents.Write"/>, or both.
+    /// </param>
+    /// <param name="callback">
+    /// The method to call. It receives the file descriptor and the conditions that are ready.
+    /// </param>
+    /// <exception cref="ArgumentNullException"><paramref name="callback"/> is null.</exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="fd"/> is negative, or <paramref name="events"/> does not include
+    /// <see cref="FileDescriptorEvents.Read"/> or <see cref="FileDescriptorEvents.Write"/>.
+    /// </exception>
+    /// <exception cref="PlatformNotSupportedException">The operating system is not Linux.</exception>
+    /// <exception cref="TerminalFormsException">
+    /// The file descriptor cannot be watched, for example because it is a regular file.
+    /// </exception>
+    /// <remarks>
+    /// <para>
+    /// A separate watcher thread waits on the file descriptor with epoll, so the application still sleeps until
+    /// there is something to do; nothing polls. When the file descriptor becomes ready, the watcher thread wakes
+    /// the event loop, and the callback runs on the UI thread on its next pass, between input events, so it may
+    /// update controls directly.
+    /// </para>
+    /// <para>
+    /// The watch is level-triggered: if the callback leaves data unread, it is called again on the next pass.
+    /// Watching a file descriptor that is already watched replaces its conditions and callback. Call
+    /// <see cref="UnwatchFileDescriptor"/> before closing the file descriptor.
+    /// </para>
+    /// </remarks>
+    public static void WatchFileDescriptor(
+        int fd,
+        FileDescriptorEvents events,
+        Action<int, FileDescriptorEvents> callback
+    )
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(fd);
+        ArgumentNullException.ThrowIfNull(callback);
+        if (
+            (events & ~(FileDescriptorEvents.Read | FileDescriptorEvents.Write)) != 0
+            || (events & (FileDescriptorEvents.Read | FileDescriptorEvents.Write)) == 0
+        )
+            throw new ArgumentOutOfRangeException(nameof(events));
+        if (!OperatingSystem.IsLinux())
+            throw new PlatformNotSupportedException(
+                "File descriptor watches are only supported on Linux."
+            );
+
+        Check(
+            NativeMethods.TfApplicationStaticWatchFd(
+                fd,
+                (int)events,
+                &NativeFileDescriptorCallback,
+                null
+            )
+        );
+        _fileDescriptorWatches[fd] = callback;
+    }
+
+    /// <summary>
+    /// Stops watching a file descriptor that was passed to <see cref="WatchFileDescriptor"/>.
+    /// </summary>
+    /// <param name="fd">The file descriptor to stop watching.</param>
+    /// <remarks>
+    /// The callback is not called again, even if the file descriptor was already ready. Does nothing if the file
+    /// descriptor is not watched.
+    /// </remarks>
+    public static void UnwatchFileDescriptor(int fd)
+    {
+        if (!_fileDescriptorWatches.Remove(fd))
+            return;
+        Check(NativeMethods.TfApplicationStaticUnwatchFd(fd));
+    }
+
+    /// <summary>
+    /// Gets a value indicating whether the caller must call <see cref="Invoke"/> or
+    /// <see cref="BeginInvoke"/> to work with forms and controls, because it is not on the UI thread.
+    /// </summary>
+    /// <value>
+    /// <see langword="true"/> if the calling thread is not the UI thread; otherwise, <see langword="false"/>.
+    /// </value>
+    /// <remarks>
+    /// The UI thread is the one that called <see cref="Run"/>. Before that, it is the thread that first used the
+    /// <see cref="Application"/> class, which is normally the one that creates the forms and then calls
+    /// <see cref="Run"/>.
+    /// </remarks>
+    public static bool InvokeRequired => Environment.CurrentManagedThreadId != _uiThreadId;
+
+    /// <summary>
+    /// Queues a method to run on the UI thread and returns without waiting for it.
+    /// </summary>
+    /// <param name="action">The method to run.</param>
+    /// <exception cref="ArgumentNullException"><paramref name="action"/> is null.</exception>
+    /// <remarks>
+    /// <para>
+    /// This may be called from any thread, and never blocks: the method is added to a lock-free queue, and the
+    /// event loop is woken if it is asleep. The event loop runs the queued methods in the order they were queued,
+    /// in batches, on each pass. Methods queued before <see cref="Run"/> run once it starts.
+    /// </para>
+    /// <para>
+    /// Exceptions thrown by <paramref name="action"/> are ignored.
+    /// </para>
+    /// </remarks>
+    public static void BeginInvoke(Action action)
+    {
+        ArgumentNullException.ThrowIfNull(action);
+        var handle = GCHandle.Alloc(action);
+        var error = NativeMethods.TfApplicationStaticPost(
+            &NativePostCallback,
+            (void*)GCHandle.ToIntPtr(handle)
+        );
+        if (error != Error.Success)
+        {
+            handle.Free();
+            Check(error);
+        }
+    }
+
+    /// <summary>
+    /// Runs a method on the UI thread and waits for it to finish.
+    /// </summary>
+    /// <param name="action">The method to run.</param>
+    /// <exception cref="ArgumentNullException"><paramref name="action"/> is null.</exception>
+    /// <remarks>
+    /// On the UI thread, <paramref name="action"/> runs at once, even before <see cref="Run"/> is called. On any other thread, it is queued as by
+    /// <see cref="BeginInvoke"/>, and this method blocks until the event loop has run it, so it must not be
+    /// called from another thread that the UI thread is waiting for. An exception thrown by
+    /// <paramref name="action"/> is rethrown to the caller.
+    /// </remarks>
+    public static void Invoke(Action action)
+    {
+        ArgumentNullException.ThrowIfNull(action);
+        if (!InvokeRequired)
+        {
+            action();
+            return;
+        }
+
+        using var done = new ManualResetEventSlim();
+        Exception? exception = null;
+        BeginInvoke(() =>
+        {
+            try
+            {
+                action();
+            }
+            catch (Exception ex)
+            {
+                exception = ex;
+            }
+            finally
+            {
+                done.Set();
+            }
+        });
+        done.Wait();
+        if (exception is not null)
+            ExceptionDispatchInfo.Throw(exception);
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativePostCallback(void* userData)
+    {
+        try
+        {
+            var handle = GCHandle.FromIntPtr((IntPtr)userData);
+            var action = (Action)handle.Target!;
+            handle.Free();
+            action();
+        }
+        catch { }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativeFileDescriptorCallback(void* userData, int fd, int events)
+    {
+        try
+        {
+            if (_fileDescriptorWatches.TryGetValue(fd, out var callback))
+                callback(fd, (FileDescriptorEvents)events);
+        }
+        catch { }
+    }
+
     private static partial class NativeMethods
     {
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticWatchFd(
+            int fd,
+            int events,
+            delegate* unmanaged[Cdecl]<void*, int, int, void> function,
+            void* userData
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticUnwatchFd(int fd);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticGetDeferredDrawing(
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticSetDeferredDrawing(
+            [MarshalAs(UnmanagedType.I4)] bool value
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticGetMaxFrameRate(out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticSetMaxFrameRate(int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticFlushFrame();
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticGetFrameCounters(
+            out long frames,
+            out long invalidations,
+            out long draws
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticGetTimerSlack(out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticSetTimerSlack(int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfApplicationStaticPost(
+            delegate* unmanaged[Cdecl]<void*, void> function,
+            void* userData
+        );
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfApplicationStaticRun();
 
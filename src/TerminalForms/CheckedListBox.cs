@@ -0,0 +1,297 @@
+using System.Runtime.CompilerServices;
+
+namespace TerminalForms;
+
+/// <summary>
+/// Represents a <see cref="ListBox"/> that displays a check box next to each item.
+/// </summary>
+/// <remarks>
+/// Pressing Space or clicking an item's check box toggles it; Space does not raise
+/// <see cref="ListBox.ItemActivated"/> as it does in a plain list box. The focused item and the selection
+/// work as they do in <see cref="ListBox"/>, independently of which items are checked.
+///
+/// Check state is stored as one bit per item, so a list of thousands of options needs only a few hundred
+/// bytes for it, and <see cref="CheckedCount"/> is kept up to date rather than counted. Checked items stay
+/// checked as items are inserted, removed, or sorted around them. Use <see cref="GetCheckedBits"/> and
+/// <see cref="SetCheckedBits"/> to read or write the state of many items in one call.
+/// </remarks>
+/// <example>
+/// <code>
+/// var checkedListBox = new CheckedListBox("Bold", "Italic", "Underline");
+/// checkedListBox.SetItemChecked(0, true);
+///
+/// checkedListBox.CheckedItemsChanged += (sender, e) =>
+/// {
+///     Console.WriteLine($"{checkedListBox.CheckedCount} checked");
+/// };
+///
+/// form.Controls.Add(checkedListBox);
+/// </code>
+/// </example>
+public unsafe partial class CheckedListBox : ListBox
+{
+    private static readonly MetaObject _metaObject = new(
+        NativeMethods.TfCheckedListBoxNew,
+        NativeMethods.TfCheckedListBoxDelete,
+        NativeMethods.TfCheckedListBoxEquals,
+        NativeMethods.TfCheckedListBoxHash
+    );
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="CheckedListBox"/> class with an empty item list.
+    /// </summary>
+    public CheckedListBox()
+        : base(_metaObject)
+    {
+        Check(
+            NativeMethods.TfCheckedListBoxSetCheckedItemsChangedEventHandler(
+                Ptr,
+                &NativeCheckedItemsChangedEventHandler,
+                Ptr
+            )
+        );
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="CheckedListBox"/> class with the specified items,
+    /// all unchecked.
+    /// </summary>
+    /// <param name="items">The initial items to display in the list box.</param>
+    /// <exception cref="ArgumentNullException">
+    /// <paramref name="items"/> is null, or any item in the array is null.
+    /// </exception>
+    public CheckedListBox(params string[] items)
+        : this()
+    {
+        ArgumentNullException.ThrowIfNull(items);
+        Items.AddRange(items);
+    }
+
+    /// <summary>
+    /// Gets the number of checked items.
+    /// </summary>
+    /// <value>The number of checked items. Reading it takes constant time, however many items there are.</value>
+    public int CheckedCount
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfCheckedListBoxGetCheckedCount(Ptr, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Determines whether the item at the specified index is checked.
+    /// </summary>
+    /// <param name="index">The zero-based index of the item.</param>
+    /// <returns>true if the item is checked; otherwise, false.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> is less than 0 or greater than or equal to the number of items.
+    /// </exception>
+    public bool GetItemChecked(int index)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        if (index < 0 || index >= ItemCount)
+            throw new ArgumentOutOfRangeException(nameof(index));
+        Check(NativeMethods.TfCheckedListBoxGetItemChecked(Ptr, index, out var value));
+        return value;
+    }
+
+    /// <summary>
+    /// Checks or unchecks the item at the specified index.
+    /// </summary>
+    /// <param name="index">The zero-based index of the item.</param>
+    /// <param name="value">true to check the item; false to uncheck it.</param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> is less than 0 or greater than or equal to the number of items.
+    /// </exception>
+    public void SetItemChecked(int index, bool value)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        if (index < 0 || index >= ItemCount)
+            throw new ArgumentOutOfRangeException(nameof(index));
+        Check(NativeMethods.TfCheckedListBoxSetItemsChecked(Ptr, index, 1, value));
+    }
+
+    /// <summary>
+    /// Checks or unchecks a range of items.
+    /// </summary>
+    /// <param name="index">The zero-based index of the first item.</param>
+    /// <param name="count">The number of items.</param>
+    /// <param name="value">true to check the items; false to uncheck them.</param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> or <paramref name="count"/> is less than 0, or they do not denote a valid
+    /// range of items.
+    /// </exception>
+    /// <remarks>
+    /// <see cref="CheckedItemsChanged"/> is raised once if any item changed.
+    /// </remarks>
+    public void SetItemsChecked(int index, int count, bool value)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ThrowIfInvalidRange(index, count);
+        Check(NativeMethods.TfCheckedListBoxSetItemsChecked(Ptr, index, count, value));
+    }
+
+    /// <summary>
+    /// Gets the check state of a range of items as packed bits.
+    /// </summary>
+    /// <param name="index">The zero-based index of the first item.</param>
+    /// <param name="count">The number of items.</param>
+    /// <returns>
+    /// <c>(count + 7) / 8</c> bytes. Item <c>index + i</c> is bit <c>i % 8</c> of byte <c>i / 8</c>, counting
+    /// from the least significant bit; unused bits of the last byte are zero.
+    /// </returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> or <paramref name="count"/> is less than 0, or they do not denote a valid
+    /// range of items.
+    /// </exception>
+    public byte[] GetCheckedBits(int index, int count)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ThrowIfInvalidRange(index, count);
+        var bits = new byte[(count + 7L) / 8];
+        fixed (byte* bitsPtr = bits)
+        {
+            Check(NativeMethods.TfCheckedListBoxGetCheckedBits(Ptr, index, count, bitsPtr));
+        }
+        return bits;
+    }
+
+    /// <summary>
+    /// Sets the check state of a range of items from packed bits.
+    /// </summary>
+    /// <param name="index">The zero-based index of the first item.</param>
+    /// <param name="count">The number of items.</param>
+    /// <param name="bits">
+    /// At least <c>(count + 7) / 8</c> bytes, laid out as <see cref="GetCheckedBits"/> returns them. Unused
+    /// bits of the last byte are ignored.
+    /// </param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> or <paramref name="count"/> is less than 0, they do not denote a valid
+    /// range of items, or <paramref name="bits"/> is too short.
+    /// </exception>
+    /// <remarks>
+    /// <see cref="CheckedItemsChanged"/> is raised once if any item changed.
+    /// </remarks>
+    public void SetCheckedBits(int index, int count, ReadOnlySpan<byte> bits)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ThrowIfInvalidRange(index, count);
+        if (bits.Length < (count + 7L) / 8)
+            throw new ArgumentOutOfRangeException(nameof(bits));
+        fixed (byte* bitsPtr = bits)
+        {
+            Check(NativeMethods.TfCheckedListBoxSetCheckedBits(Ptr, index, count, bitsPtr));
+        }
+    }
+
+    private void ThrowIfInvalidRange(int index, int count)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(index);
+        ArgumentOutOfRangeException.ThrowIfNegative(count);
+        if (index > ItemCount - count)
+            throw new ArgumentOutOfRangeException(nameof(count));
+    }
+
+    #region CheckedItemsChanged Event
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativeCheckedItemsChangedEventHandler(void* userData)
+    {
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return;
+
+            var checkedListBox = (CheckedListBox)obj!;
+            ObjectDisposedException.ThrowIf(checkedListBox.IsDisposed, checkedListBox);
+            checkedListBox.OnCheckedItemsChanged();
+        }
+        catch { }
+    }
+
+    /// <summary>
+    /// Occurs when items are checked or unchecked.
+    /// </summary>
+    /// <remarks>
+    /// This event fires once per user action or method call, however many items it changed, and also when
+    /// removing or replacing items removes checked ones.
+    /// </remarks>
+    public event EventHandler? CheckedItemsChanged;
+
+    /// <summary>
+    /// Raises the <see cref="CheckedItemsChanged"/> event.
+    /// </summary>
+    /// <remarks>
+    /// When overriding this method in derived classes, be sure to call the base implementation
+    /// to ensure that registered event handlers are properly invoked.
+    /// </remarks>
+    protected virtual void OnCheckedItemsChanged()
+    {
+        CheckedItemsChanged?.Invoke(this, EventArgs.Empty);
+    }
+
+    #endregion
+
+    private static partial class NativeMethods
+    {
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxNew(out void* @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxDelete(void* self);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxEquals(
+            void* self,
+            void* other,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxHash(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxSetCheckedItemsChangedEventHandler(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, void> function,
+            void* userData
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxGetItemChecked(
+            void* self,
+            int index,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxSetItemsChecked(
+            void* self,
+            int index,
+            int count,
+            [MarshalAs(UnmanagedType.I4)] bool @checked
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxGetCheckedCount(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxGetCheckedBits(
+            void* self,
+            int index,
+            int count,
+            byte* bits
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfCheckedListBoxSetCheckedBits(
+            void* self,
+            int index,
+            int count,
+            byte* bits
+        );
+    }
+}
@@ -0,0 +1,14 @@
+namespace TerminalForms;
+
+/// <summary>
+/// Counts the drawing done by the application since it started. See <see cref="Application.GetFrameCounters"/>.
+/// </summary>
+/// <param name="Frames">The number of deferred frames drawn.</param>
+/// <param name="Invalidations">
+/// The number of times a property change asked for a control to be redrawn.
+/// </param>
+/// <param name="Draws">
+/// The number of times a control was actually drawn in response. Without deferred drawing this equals
+/// <paramref name="Invalidations"/>; with it, the difference is the redraws that were saved.
+/// </param>
+public record struct FrameCounters(long Frames, long Invalidations, long Draws);
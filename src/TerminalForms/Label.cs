@@ -43,6 +43,11 @@ public unsafe partial class Label : Control
     ///
     /// If <see cref="UseMnemonic"/> is disabled, tilde characters will be displayed literally
     /// without creating hotkey functionality.
+    ///
+    /// A label one row high shows a single line, cut off at its right edge. A taller label wraps the text at
+    /// line feeds and spaces, and works the rows out only when the text or the label's size changes, not each
+    /// time it is drawn. Setting the text the label already shows does nothing, so a label can be updated on
+    /// every refresh without redrawing it when its value has not moved.
     /// </remarks>
     public string Text
     {
@@ -1,7 +1,35 @@
 using System.Runtime.CompilerServices;
+using System.Text.Unicode;
 
 namespace TerminalForms;
 
+/// <summary>
+/// Specifies how a <see cref="ListBox"/> orders its items.
+/// </summary>
+public enum ListBoxSortOrder
+{
+    /// <summary>
+    /// Items stay in the order they were added (default behavior).
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// Items are sorted by the bytes of their UTF-8 text, so uppercase letters come before lowercase ones.
+    /// </summary>
+    Ordinal = 1,
+
+    /// <summary>
+    /// Items are sorted alphabetically, ignoring the case of ASCII letters.
+    /// </summary>
+    IgnoreCase = 2,
+
+    /// <summary>
+    /// Items are sorted like <see cref="IgnoreCase"/>, except that runs of digits compare by their numeric
+    /// value, so "Item 9" comes before "Item 10".
+    /// </summary>
+    Natural = 3,
+}
+
 /// <summary>
 /// Represents a scrollable list of string items that allows the user to select a single item.
 /// The list box displays items in a vertical scrollable list, with keyboard and mouse support
@@ -51,6 +79,8 @@ public unsafe partial class ListBox : Control
     );
 
     private ListBoxItemCollection? _items;
+    private Func<int, string>? _virtualItemProvider;
+    private int _virtualListSize;
 
     /// <summary>
     /// Initializes a new instance of the <see cref="ListBox"/> class with an empty item list.
@@ -61,7 +91,10 @@ public unsafe partial class ListBox : Control
     /// A vertical scrollbar is automatically created and managed by the control.
     /// </remarks>
     public ListBox()
-        : base(_metaObject)
+        : this(_metaObject) { }
+
+    internal ListBox(MetaObject metaObject)
+        : base(metaObject)
     {
         Check(
             NativeMethods.TfListBoxSetSelectedIndexChangedEventHandler(
@@ -77,6 +110,13 @@ public unsafe partial class ListBox : Control
                 Ptr
             )
         );
+        Check(
+            NativeMethods.TfListBoxSetSelectionChangedEventHandler(
+                Ptr,
+                &NativeSelectionChangedEventHandler,
+                Ptr
+            )
+        );
     }
 
     /// <summary>
@@ -91,12 +131,7 @@ public unsafe partial class ListBox : Control
         : this()
     {
         ArgumentNullException.ThrowIfNull(items);
-
-        foreach (var item in items)
-        {
-            ArgumentNullException.ThrowIfNull(item);
-            Items.Add(item);
-        }
+        Items.AddRange(items);
     }
 
     /// <summary>
@@ -139,6 +174,10 @@ public unsafe partial class ListBox : Control
     /// <see cref="SelectedIndexChanged"/> event. Setting to -1 clears the selection
     /// (though if items exist, focus remains on the first item for keyboard navigation).
     /// The event fires for both programmatic and user-initiated changes.
+    ///
+    /// The index always refers to <see cref="Items"/>, even while a <see cref="Filter"/> hides some of them.
+    /// Setting it to an item that the filter hides leaves the selection unchanged.
+    /// Use <see cref="SelectedDisplayIndex"/> to work with the rows as displayed.
     /// </remarks>
     public int SelectedIndex
     {
@@ -151,7 +190,7 @@ public unsafe partial class ListBox : Control
         set
         {
             ObjectDisposedException.ThrowIf(IsDisposed, this);
-            var count = Items.Count;
+            var count = ItemCount;
             if (count == 0)
             {
                 if (value != -1)
@@ -187,7 +226,8 @@ public unsafe partial class ListBox : Control
     /// Setting this property finds the matching item in the collection and sets
     /// <see cref="SelectedIndex"/> accordingly. The comparison is case-sensitive.
     /// If the same string appears multiple times, the first occurrence is selected.
-    /// Setting to null clears the selection.
+    /// Setting to null clears the selection. In virtual mode, only null can be set;
+    /// use <see cref="SelectedIndex"/> instead.
     /// </remarks>
     public string? SelectedItem
     {
@@ -195,9 +235,9 @@ public unsafe partial class ListBox : Control
         {
             ObjectDisposedException.ThrowIf(IsDisposed, this);
             var index = SelectedIndex;
-            if (index < 0 || index >= Items.Count)
+            if (index < 0 || index >= ItemCount)
                 return null;
-            return Items[index];
+            return _virtualItemProvider != null ? _virtualItemProvider(index) : Items[index];
         }
         set
         {
@@ -207,6 +247,12 @@ public unsafe partial class ListBox : Control
                 ClearSelection();
                 return;
             }
+            if (_virtualItemProvider != null)
+            {
+                throw new InvalidOperationException(
+                    "SelectedItem cannot be set while VirtualItemProvider is set. Use SelectedIndex instead."
+                );
+            }
             var index = Items.IndexOf(value);
             if (index < 0)
             {
@@ -219,6 +265,348 @@ public unsafe partial class ListBox : Control
         }
     }
 
+    /// <summary>
+    /// Gets or sets the text that items must contain to be displayed.
+    /// </summary>
+    /// <value>
+    /// The filter text, or an empty string to display every item. The default is an empty string.
+    /// </value>
+    /// <exception cref="ArgumentNullException">The value being set is null.</exception>
+    /// <exception cref="InvalidOperationException">
+    /// The value is set while <see cref="VirtualItemProvider"/> is set.
+    /// </exception>
+    /// <remarks>
+    /// Only items that contain the filter text are displayed; case is ignored for ASCII letters.
+    /// The <see cref="Items"/> collection is not changed, and items added while a filter is set are
+    /// shown only if they match it. Setting the filter to text that contains the previous filter, such as
+    /// after the user types another character, only searches the items that were already displayed.
+    ///
+    /// If the selected item is hidden by the filter, the selection moves to the next displayed item and
+    /// <see cref="SelectedIndexChanged"/> is raised.
+    /// </remarks>
+    public string Filter
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetFilter(Ptr, out var value));
+            return value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            ArgumentNullException.ThrowIfNull(value);
+            if (_virtualItemProvider != null)
+            {
+                throw new InvalidOperationException(
+                    "Filter cannot be set while VirtualItemProvider is set."
+                );
+            }
+            Check(NativeMethods.TfListBoxSetFilter(Ptr, value));
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of rows displayed, which is the number of items that match the <see cref="Filter"/>.
+    /// </summary>
+    /// <value>The number of displayed rows.</value>
+    public int DisplayCount
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetDisplayCount(Ptr, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets the zero-based position of the selected item among the displayed rows.
+    /// </summary>
+    /// <value>
+    /// The zero-based display row of the selected item, or -1 if no item is selected.
+    /// This equals <see cref="SelectedIndex"/> unless a <see cref="Filter"/> is set.
+    /// </value>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// The value being set is less than -1 or greater than or equal to <see cref="DisplayCount"/>.
+    /// </exception>
+    public int SelectedDisplayIndex
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetSelectedDisplayIndex(Ptr, out var value));
+            return value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            var count = DisplayCount;
+            if (value < -1 || value >= count || (count == 0 && value != -1))
+            {
+                throw new ArgumentOutOfRangeException(
+                    nameof(value),
+                    count == 0
+                        ? "SelectedDisplayIndex must be -1 when no rows are displayed."
+                        : $"SelectedDisplayIndex must be between -1 and {count - 1}."
+                );
+            }
+            Check(NativeMethods.TfListBoxSetSelectedDisplayIndex(Ptr, value));
+        }
+    }
+
+    /// <summary>
+    /// Gets the index in <see cref="Items"/> of the item shown at the specified display row.
+    /// </summary>
+    /// <param name="displayIndex">The zero-based display row.</param>
+    /// <returns>The zero-based index of the item in <see cref="Items"/>.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="displayIndex"/> is less than 0 or greater than or equal to <see cref="DisplayCount"/>.
+    /// </exception>
+    public int GetSourceIndex(int displayIndex)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        if (displayIndex < 0 || displayIndex >= DisplayCount)
+            throw new ArgumentOutOfRangeException(nameof(displayIndex));
+        Check(NativeMethods.TfListBoxGetSourceIndex(Ptr, displayIndex, out var value));
+        return value;
+    }
+
+    /// <summary>
+    /// Finds the item that starts with the specified text, ignoring case.
+    /// </summary>
+    /// <param name="prefix">The text to search for at the start of each item.</param>
+    /// <returns>
+    /// The zero-based index of the matching item, or -1 if no item starts with <paramref name="prefix"/>.
+    /// If several items match, the one that comes first in case-insensitive alphabetical order is returned;
+    /// among identical items, the one with the lowest index.
+    /// </returns>
+    /// <exception cref="ArgumentNullException"><paramref name="prefix"/> is null.</exception>
+    /// <exception cref="InvalidOperationException"><see cref="VirtualItemProvider"/> is set.</exception>
+    /// <remarks>
+    /// The first search builds a sorted index of the items, which is then kept up to date as items change,
+    /// so each search takes logarithmic time. Case is ignored for ASCII letters only.
+    /// The same search moves the selection when the user types while the list box has focus.
+    /// </remarks>
+    public int FindPrefix(string prefix)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ArgumentNullException.ThrowIfNull(prefix);
+        if (_virtualItemProvider != null)
+        {
+            throw new InvalidOperationException(
+                "FindPrefix cannot be used while VirtualItemProvider is set."
+            );
+        }
+        Check(NativeMethods.TfListBoxFindPrefix(Ptr, prefix, out var index));
+        return index;
+    }
+
+    /// <summary>
+    /// Gets or sets how the items are ordered.
+    /// </summary>
+    /// <value>
+    /// A <see cref="ListBoxSortOrder"/> value. The default is <see cref="ListBoxSortOrder.None"/>.
+    /// </value>
+    /// <exception cref="InvalidOperationException">
+    /// The value is set while <see cref="VirtualItemProvider"/> is set.
+    /// </exception>
+    /// <remarks>
+    /// While a sort order is set, the <see cref="Items"/> collection is kept sorted:
+    /// <see cref="ListBoxItemCollection.Add"/> and <see cref="ListBoxItemCollection.Insert"/> put the item
+    /// where it belongs, ignoring the requested index, and replacing an item moves it to where its new text
+    /// belongs. Each of these is a binary search plus one move of the items after it, rather than a full sort.
+    /// <see cref="ListBoxItemCollection.AddRange"/> sorts the new items and merges them in.
+    /// Items that compare equal keep the order they were added in.
+    ///
+    /// Setting a sort order sorts the existing items once, keeping the selected item selected.
+    /// Setting it back to <see cref="ListBoxSortOrder.None"/> leaves the items in their current order.
+    /// </remarks>
+    public ListBoxSortOrder SortOrder
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetSortOrder(Ptr, out var value));
+            return (ListBoxSortOrder)value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (_virtualItemProvider != null)
+            {
+                throw new InvalidOperationException(
+                    "SortOrder cannot be set while VirtualItemProvider is set."
+                );
+            }
+            if (value != SortOrder)
+            {
+                // The native items are reordered before SelectedIndexChanged is raised, so the collection
+                // must read them back rather than serve the old order to the handler.
+                if (value != ListBoxSortOrder.None)
+                    _items?.InvalidateMirror();
+                Check(NativeMethods.TfListBoxSetSortOrder(Ptr, (int)value));
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of bytes of native memory used to store <see cref="Items"/> and the state kept for them.
+    /// </summary>
+    /// <value>
+    /// The size of the native item storage and its companion structures in bytes, including capacity reserved
+    /// for future items.
+    /// </value>
+    /// <remarks>
+    /// <para>
+    /// Item text is stored as UTF-8 in a single contiguous buffer with a 12-byte index entry per item, holding
+    /// its offset, length and display width, so this grows with the total length of the items rather than with
+    /// per-item allocations.
+    /// </para>
+    /// <para>
+    /// The total also counts the prefix index used by <see cref="FindPrefix"/> and type-ahead (4 bytes per item,
+    /// once it has been built), the rows shown through <see cref="Filter"/> (4 bytes per row while a filter is
+    /// set), the ranges of selected items in multi-select mode, and the bitset of checked items.
+    /// </para>
+    /// </remarks>
+    public long ItemMemoryUsage
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetMemoryUsage(Ptr, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of screen cells this control has drawn since it was created.
+    /// </summary>
+    /// <value>A running total of the cells written, including every full redraw.</value>
+    /// <remarks>
+    /// Moving the focus repaints only the rows it left and entered, and replacing an item repaints only
+    /// its row, unless the list scrolls. Compare the value before and after a change to see how much of
+    /// the control it repainted.
+    /// </remarks>
+    public long CellsWritten
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetCellsWritten(Ptr, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets the function that supplies the text of each row when the list box is in
+    /// virtual mode.
+    /// </summary>
+    /// <value>
+    /// A function that returns the text of the row at the given zero-based index, or null
+    /// to display the <see cref="Items"/> collection.
+    /// </value>
+    /// <remarks>
+    /// In virtual mode the list box stores no rows. It displays <see cref="VirtualListSize"/>
+    /// rows and calls this function only for the rows that are visible, so memory use and
+    /// load time do not grow with the number of rows. Use this for lists with millions of rows.
+    ///
+    /// Setting this property resets <see cref="VirtualListSize"/> to 0 and moves the selection
+    /// back to the top. While it is set, the <see cref="Items"/> collection cannot be modified.
+    /// Setting it back to null displays the <see cref="Items"/> collection again.
+    /// </remarks>
+    /// <example>
+    /// <code>
+    /// var listBox = new ListBox();
+    /// listBox.VirtualItemProvider = index => $"Row {index}";
+    /// listBox.VirtualListSize = 5_000_000;
+    /// </code>
+    /// </example>
+    public Func<int, string>? VirtualItemProvider
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            return _virtualItemProvider;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            _virtualItemProvider = value;
+            _virtualListSize = 0;
+            if (value == null)
+                Check(NativeMethods.TfListBoxSetVirtualSource(Ptr, null, null));
+            else
+                Check(NativeMethods.TfListBoxSetVirtualSource(Ptr, &NativeVirtualTextFunction, Ptr));
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets the number of rows displayed in virtual mode.
+    /// </summary>
+    /// <value>The number of rows that <see cref="VirtualItemProvider"/> can supply.</value>
+    /// <exception cref="InvalidOperationException">
+    /// The value is set while <see cref="VirtualItemProvider"/> is null.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">The value being set is negative.</exception>
+    /// <remarks>
+    /// If the selected row no longer exists after the size shrinks, the selection moves to the
+    /// last row and <see cref="SelectedIndexChanged"/> is raised.
+    /// </remarks>
+    public int VirtualListSize
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            return _virtualListSize;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (_virtualItemProvider == null)
+            {
+                throw new InvalidOperationException(
+                    "VirtualListSize can only be set while VirtualItemProvider is set."
+                );
+            }
+            ArgumentOutOfRangeException.ThrowIfNegative(value);
+            Check(NativeMethods.TfListBoxSetVirtualCount(Ptr, value));
+            _virtualListSize = value;
+        }
+    }
+
+    private protected int ItemCount => _virtualItemProvider != null ? _virtualListSize : Items.Count;
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static int NativeVirtualTextFunction(
+        void* userData,
+        int index,
+        byte* buffer,
+        int bufferSize
+    )
+    {
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return 0;
+
+            var listBox = (ListBox)obj!;
+            var text = listBox._virtualItemProvider?.Invoke(index) ?? string.Empty;
+            if (bufferSize > 0)
+            {
+                // Writes only whole characters, so a truncated row never ends in a partial sequence.
+                var span = new Span<byte>(buffer, bufferSize - 1);
+                Utf8.FromUtf16(text, span, out _, out var written);
+                buffer[written] = 0;
+            }
+            return Global.UTF8Encoding.GetByteCount(text);
+        }
+        catch
+        {
+            return 0;
+        }
+    }
+
     /// <summary>
     /// Clears the current selection, setting <see cref="SelectedIndex"/> to -1.
     /// </summary>
@@ -227,6 +615,9 @@ public unsafe partial class ListBox : Control
     /// purposes, but the <see cref="SelectedIndex"/> will report -1 to indicate no
     /// logical selection. Use this method when you want to reset the list to an
     /// unselected state.
+    ///
+    /// When <see cref="MultiSelect"/> is true, this deselects every item instead and leaves the focused
+    /// item where it is.
     /// </remarks>
     public void ClearSelection()
     {
@@ -234,6 +625,171 @@ public unsafe partial class ListBox : Control
         Check(NativeMethods.TfListBoxClearSelection(Ptr));
     }
 
+    /// <summary>
+    /// Gets or sets a value indicating whether more than one item can be selected.
+    /// </summary>
+    /// <value>
+    /// true if any set of items can be selected; false if only <see cref="SelectedIndex"/> is selected.
+    /// The default is false.
+    /// </value>
+    /// <remarks>
+    /// While multi-select is on, <see cref="SelectedIndex"/> is the focused item, which the user moves with
+    /// the arrow keys, and the selected items are reported by <see cref="GetSelectedRanges"/>.
+    /// Moving the focus selects only the focused item; with Shift held, it selects every displayed row
+    /// from the item where the selection started. Ctrl+click and Space toggle a single item,
+    /// and Ctrl+A selects every displayed row.
+    ///
+    /// The selection is stored as ranges of consecutive indices rather than a flag per item, so selecting
+    /// every item of a very large list takes constant memory. Turning multi-select on or off keeps the
+    /// focused item selected.
+    /// </remarks>
+    public bool MultiSelect
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetMultiSelect(Ptr, out var value));
+            return value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxSetMultiSelect(Ptr, value));
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of selected items.
+    /// </summary>
+    /// <value>
+    /// The number of selected items. When <see cref="MultiSelect"/> is false, this is 1 if an item is
+    /// selected and 0 otherwise.
+    /// </value>
+    public int SelectedCount
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfListBoxGetSelectedCount(Ptr, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Determines whether the item at the specified index is selected.
+    /// </summary>
+    /// <param name="index">The zero-based index of the item.</param>
+    /// <returns>true if the item is selected; otherwise, false.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> is less than 0 or greater than or equal to the number of items.
+    /// </exception>
+    public bool GetSelected(int index)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        if (index < 0 || index >= ItemCount)
+            throw new ArgumentOutOfRangeException(nameof(index));
+        Check(NativeMethods.TfListBoxGetItemSelected(Ptr, index, out var value));
+        return value;
+    }
+
+    /// <summary>
+    /// Selects or deselects a range of items.
+    /// </summary>
+    /// <param name="index">The zero-based index of the first item.</param>
+    /// <param name="count">The number of items.</param>
+    /// <param name="value">true to select the items; false to deselect them.</param>
+    /// <exception cref="InvalidOperationException"><see cref="MultiSelect"/> is false.</exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> or <paramref name="count"/> is less than 0, or they do not denote a valid
+    /// range of items.
+    /// </exception>
+    /// <remarks>
+    /// The focused item does not move. <see cref="SelectionChanged"/> is raised once if any item changed.
+    /// </remarks>
+    public void SetSelected(int index, int count, bool value)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ThrowIfNotMultiSelect();
+        ArgumentOutOfRangeException.ThrowIfNegative(index);
+        ArgumentOutOfRangeException.ThrowIfNegative(count);
+        if (index > ItemCount - count)
+            throw new ArgumentOutOfRangeException(nameof(count));
+        Check(NativeMethods.TfListBoxSetItemsSelected(Ptr, index, count, value));
+    }
+
+    /// <summary>
+    /// Selects every displayed item.
+    /// </summary>
+    /// <exception cref="InvalidOperationException"><see cref="MultiSelect"/> is false.</exception>
+    /// <remarks>
+    /// Items hidden by the <see cref="Filter"/> keep their current state. Without a filter this takes
+    /// constant time and memory, however many items there are.
+    /// </remarks>
+    public void SelectAll()
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ThrowIfNotMultiSelect();
+        Check(NativeMethods.TfListBoxSelectAll(Ptr));
+    }
+
+    /// <summary>
+    /// Gets the selected items as ranges of consecutive indices.
+    /// </summary>
+    /// <returns>
+    /// The selected ranges in ascending order. Ranges never overlap or touch, so a selection of every item
+    /// is a single range.
+    /// </returns>
+    public IReadOnlyList<(int Index, int Count)> GetSelectedRanges()
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        Check(NativeMethods.TfListBoxGetSelectedRangeCount(Ptr, out var rangeCount));
+        var ranges = new (int Index, int Count)[rangeCount];
+        var buffer = new int[Math.Max(Math.Min(rangeCount, 1024), 1) * 2];
+        var first = 0;
+        fixed (int* bufferPtr = buffer)
+        {
+            while (first < rangeCount)
+            {
+                Check(
+                    NativeMethods.TfListBoxGetSelectedRanges(
+                        Ptr,
+                        first,
+                        bufferPtr,
+                        buffer.Length / 2,
+                        out var written
+                    )
+                );
+                if (written == 0)
+                    break;
+                for (var i = 0; i < written; i++)
+                    ranges[first + i] = (buffer[i * 2], buffer[i * 2 + 1]);
+                first += written;
+            }
+        }
+        return ranges;
+    }
+
+    /// <summary>
+    /// Gets the indices of the selected items in ascending order.
+    /// </summary>
+    /// <returns>The index of every selected item, expanded from <see cref="GetSelectedRanges"/>.</returns>
+    public IEnumerable<int> GetSelectedIndices()
+    {
+        foreach (var (index, count) in GetSelectedRanges())
+        {
+            for (var i = 0; i < count; i++)
+                yield return index + i;
+        }
+    }
+
+    private void ThrowIfNotMultiSelect()
+    {
+        if (!MultiSelect)
+        {
+            throw new InvalidOperationException("MultiSelect must be true to select several items.");
+        }
+    }
+
     #region SelectedIndexChanged Event
 
     [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
@@ -277,6 +833,47 @@ public unsafe partial class ListBox : Control
 
     #endregion
 
+    #region SelectionChanged Event
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativeSelectionChangedEventHandler(void* userData)
+    {
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return;
+
+            var listBox = (ListBox)obj!;
+            ObjectDisposedException.ThrowIf(listBox.IsDisposed, listBox);
+            listBox.OnSelectionChanged();
+        }
+        catch { }
+    }
+
+    /// <summary>
+    /// Occurs when items are selected or deselected while <see cref="MultiSelect"/> is true.
+    /// </summary>
+    /// <remarks>
+    /// This event fires once per user action or method call, however many items it changed, and also when
+    /// removing items removes selected ones. Moving the focused item raises
+    /// <see cref="SelectedIndexChanged"/> as well.
+    /// </remarks>
+    public event EventHandler? SelectionChanged;
+
+    /// <summary>
+    /// Raises the <see cref="SelectionChanged"/> event.
+    /// </summary>
+    /// <remarks>
+    /// When overriding this method in derived classes, be sure to call the base implementation
+    /// to ensure that registered event handlers are properly invoked.
+    /// </remarks>
+    protected virtual void OnSelectionChanged()
+    {
+        SelectionChanged?.Invoke(this, EventArgs.Empty);
+    }
+
+    #endregion
+
     #region ItemActivated Event
 
     [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
@@ -354,6 +951,58 @@ public unsafe partial class ListBox : Control
             void* userData
         );
 
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetSelectionChangedEventHandler(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, void> function,
+            void* userData
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetMultiSelect(
+            void* self,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetMultiSelect(
+            void* self,
+            [MarshalAs(UnmanagedType.I4)] bool value
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetItemSelected(
+            void* self,
+            int index,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetItemsSelected(
+            void* self,
+            int index,
+            int count,
+            [MarshalAs(UnmanagedType.I4)] bool selected
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSelectAll(void* self);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetSelectedCount(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetSelectedRangeCount(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetSelectedRanges(
+            void* self,
+            int firstRange,
+            int* ranges,
+            int capacity,
+            out int outCount
+        );
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfListBoxGetSelectedIndex(void* self, out int @out);
 
@@ -362,5 +1011,48 @@ public unsafe partial class ListBox : Control
 
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfListBoxClearSelection(void* self);
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfListBoxGetFilter(void* self, out string @out);
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfListBoxSetFilter(void* self, string text);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetDisplayCount(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetSelectedDisplayIndex(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetSelectedDisplayIndex(void* self, int row);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetSourceIndex(void* self, int row, out int @out);
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfListBoxFindPrefix(void* self, string prefix, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetSortOrder(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetSortOrder(void* self, int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetMemoryUsage(void* self, out long @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetVirtualSource(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, int, byte*, int, int> function,
+            void* userData
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxSetVirtualCount(void* self, long count);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxGetCellsWritten(void* self, out long @out);
     }
 }
@@ -12,11 +12,18 @@ namespace TerminalForms;
 /// Changes to the collection are immediately reflected in the visual display of the list box.
 /// When items are removed, the selected index is automatically adjusted to maintain a valid selection.
 /// Duplicate strings are allowed in the collection.
+///
+/// While <see cref="ListBox.SortOrder"/> is set, items are kept in sorted order, so an added, inserted or
+/// replaced item may end up at a different index than the one requested.
+///
+/// While <see cref="ListBox.VirtualItemProvider"/> is set, the rows come from the provider
+/// instead of this collection, and modifying the collection throws <see cref="InvalidOperationException"/>.
 /// </remarks>
 public unsafe partial class ListBoxItemCollection : IList<string>
 {
     private readonly ListBox _owner;
     private readonly List<string> _items = [];
+    private bool _mirrorStale;
 
     internal ListBoxItemCollection(ListBox owner)
     {
@@ -31,7 +38,7 @@ public unsafe partial class ListBoxItemCollection : IList<string>
         get
         {
             ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-            return _items.Count;
+            return Mirror.Count;
         }
     }
 
@@ -56,17 +63,27 @@ public unsafe partial class ListBoxItemCollection : IList<string>
         get
         {
             ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-            if (index < 0 || index >= _items.Count)
+            if (index < 0 || index >= Mirror.Count)
                 throw new ArgumentOutOfRangeException(nameof(index));
-            return _items[index];
+            return Mirror[index];
         }
         set
         {
             ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+            ThrowIfVirtual();
             ArgumentNullException.ThrowIfNull(value);
-            if (index < 0 || index >= _items.Count)
+            if (index < 0 || index >= Mirror.Count)
                 throw new ArgumentOutOfRangeException(nameof(index));
-            _items[index] = value;
+            var position = GetSortedPosition(value, index, index);
+            if (position == index)
+            {
+                _items[index] = value;
+            }
+            else
+            {
+                _items.RemoveAt(index);
+                _items.Insert(position, value);
+            }
             Check(NativeMethods.TfListBoxSetItemAt(_owner.Ptr, index, value));
         }
     }
@@ -78,15 +95,86 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     /// <exception cref="ArgumentNullException"><paramref name="item"/> is null.</exception>
     /// <remarks>
     /// If this is the first item added to an empty list, it will automatically become selected.
+    /// While <see cref="ListBox.SortOrder"/> is set, the item is inserted where it belongs instead.
     /// </remarks>
     public void Add(string item)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ThrowIfVirtual();
         ArgumentNullException.ThrowIfNull(item);
-        _items.Add(item);
+        Mirror.Insert(GetSortedPosition(item, -1, Mirror.Count), item);
         Check(NativeMethods.TfListBoxAddItem(_owner.Ptr, item));
     }
 
+    /// <summary>
+    /// Adds several items to the end of the collection in a single update.
+    /// </summary>
+    /// <param name="items">The strings to add to the collection.</param>
+    /// <exception cref="ArgumentNullException">
+    /// <paramref name="items"/> is null, or any item in it is null.
+    /// </exception>
+    /// <remarks>
+    /// This is much faster than calling <see cref="Add"/> in a loop for large numbers of items:
+    /// the list box is redrawn once and <see cref="ListBox.SelectedIndexChanged"/> is raised at most once.
+    /// If the list was empty, the first item becomes selected.
+    /// </remarks>
+    public void AddRange(IEnumerable<string> items)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ThrowIfVirtual();
+        var array = ToCheckedArray(items);
+        if (array.Length == 0)
+            return;
+        PackItems(array, out var data, out var offsets);
+
+        // Update the mirror first, so SelectedIndexChanged handlers see the new items. The native side sorts
+        // them in while a sort order is set, and the mirror reads the result back when next used.
+        if (_owner.SortOrder == ListBoxSortOrder.None)
+            Mirror.AddRange(array);
+        else
+            InvalidateMirror();
+        fixed (byte* dataPtr = data)
+        fixed (int* offsetsPtr = offsets)
+        {
+            Check(NativeMethods.TfListBoxAddItemsPacked(_owner.Ptr, dataPtr, offsetsPtr, array.Length));
+        }
+    }
+
+    /// <summary>
+    /// Replaces every item in the collection in a single update.
+    /// </summary>
+    /// <param name="items">The strings that become the new contents of the collection.</param>
+    /// <exception cref="ArgumentNullException">
+    /// <paramref name="items"/> is null, or any item in it is null.
+    /// </exception>
+    /// <remarks>
+    /// This is equivalent to <see cref="Clear"/> followed by <see cref="AddRange"/>, except that the list box is
+    /// redrawn once and <see cref="ListBox.SelectedIndexChanged"/> is raised at most once. Afterwards the first
+    /// item is selected, or <see cref="ListBox.SelectedIndex"/> is -1 if <paramref name="items"/> is empty.
+    /// </remarks>
+    public void ReplaceAll(IEnumerable<string> items)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ThrowIfVirtual();
+        var array = ToCheckedArray(items);
+        PackItems(array, out var data, out var offsets);
+        if (_owner.SortOrder == ListBoxSortOrder.None)
+        {
+            _mirrorStale = false;
+            _items.Clear();
+            _items.AddRange(array);
+        }
+        else
+        {
+            InvalidateMirror();
+        }
+        fixed (byte* dataPtr = data)
+        fixed (int* offsetsPtr = offsets)
+        {
+            Check(NativeMethods.TfListBoxReplaceItemsPacked(_owner.Ptr, dataPtr, offsetsPtr, array.Length));
+        }
+    }
+
     /// <summary>
     /// Removes all items from the collection.
     /// </summary>
@@ -97,6 +185,8 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public void Clear()
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ThrowIfVirtual();
+        _mirrorStale = false;
         _items.Clear();
         Check(NativeMethods.TfListBoxClearItems(_owner.Ptr));
     }
@@ -109,7 +199,7 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public bool Contains(string item)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-        return _items.Contains(item);
+        return Mirror.Contains(item);
     }
 
     /// <summary>
@@ -120,7 +210,7 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public void CopyTo(string[] array, int arrayIndex)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-        _items.CopyTo(array, arrayIndex);
+        Mirror.CopyTo(array, arrayIndex);
     }
 
     /// <summary>
@@ -130,7 +220,7 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public IEnumerator<string> GetEnumerator()
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-        return _items.GetEnumerator();
+        return Mirror.GetEnumerator();
     }
 
     /// <summary>
@@ -144,7 +234,7 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public int IndexOf(string item)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-        return _items.IndexOf(item);
+        return Mirror.IndexOf(item);
     }
 
     /// <summary>
@@ -159,14 +249,17 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     /// <remarks>
     /// When an item is inserted before or at the current selection, the selected index
     /// is automatically incremented to maintain the same item selected.
+    /// While <see cref="ListBox.SortOrder"/> is set, <paramref name="index"/> is ignored and the item is
+    /// inserted where it belongs.
     /// </remarks>
     public void Insert(int index, string item)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ThrowIfVirtual();
         ArgumentNullException.ThrowIfNull(item);
-        if (index < 0 || index > _items.Count)
+        if (index < 0 || index > Mirror.Count)
             throw new ArgumentOutOfRangeException(nameof(index));
-        _items.Insert(index, item);
+        Mirror.Insert(GetSortedPosition(item, -1, index), item);
         Check(NativeMethods.TfListBoxInsertItemAt(_owner.Ptr, index, item));
     }
 
@@ -188,7 +281,7 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public bool Remove(string item)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-        var index = _items.IndexOf(item);
+        var index = Mirror.IndexOf(item);
         if (index < 0)
             return false;
         RemoveAt(index);
@@ -212,27 +305,144 @@ public unsafe partial class ListBoxItemCollection : IList<string>
     public void RemoveAt(int index)
     {
         ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
-        if (index < 0 || index >= _items.Count)
+        ThrowIfVirtual();
+        if (index < 0 || index >= Mirror.Count)
             throw new ArgumentOutOfRangeException(nameof(index));
-        _items.RemoveAt(index);
+        Mirror.RemoveAt(index);
         Check(NativeMethods.TfListBoxRemoveItemAt(_owner.Ptr, index));
     }
 
+    /// <summary>
+    /// Removes a range of items from the collection in a single update.
+    /// </summary>
+    /// <param name="index">The zero-based index of the first item to remove.</param>
+    /// <param name="count">The number of items to remove.</param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> or <paramref name="count"/> is less than 0, or they do not denote a valid range
+    /// of items in the collection.
+    /// </exception>
+    /// <remarks>
+    /// The selected index is adjusted the same way as <see cref="RemoveAt"/>, treating the range as one item:
+    /// if the selected item was removed, the item that followed the range becomes selected.
+    /// </remarks>
+    public void RemoveRange(int index, int count)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ThrowIfVirtual();
+        ArgumentOutOfRangeException.ThrowIfNegative(index);
+        ArgumentOutOfRangeException.ThrowIfNegative(count);
+        if (index > Mirror.Count - count)
+            throw new ArgumentOutOfRangeException(nameof(count));
+        if (count == 0)
+            return;
+        Mirror.RemoveRange(index, count);
+        Check(NativeMethods.TfListBoxRemoveRange(_owner.Ptr, index, count));
+    }
+
     IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
 
+    // Shared with RadioButtonItemCollection, which loads items in bulk the same way.
+    internal static string[] ToCheckedArray(IEnumerable<string> items)
+    {
+        ArgumentNullException.ThrowIfNull(items);
+        var array = items.ToArray();
+        foreach (var item in array)
+            ArgumentNullException.ThrowIfNull(item, nameof(items));
+        return array;
+    }
+
+    // Encodes the items back to back into one UTF-8 buffer; item i spans offsets[i] to offsets[i + 1].
+    internal static void PackItems(string[] items, out byte[] data, out int[] offsets)
+    {
+        offsets = new int[items.Length + 1];
+        var length = 0;
+        for (var i = 0; i < items.Length; i++)
+        {
+            offsets[i] = length;
+            length = checked(length + Global.UTF8Encoding.GetByteCount(items[i]));
+        }
+        offsets[items.Length] = length;
+
+        // Never empty, so fixed() always yields a non-null pointer.
+        data = new byte[Math.Max(length, 1)];
+        for (var i = 0; i < items.Length; i++)
+            Global.UTF8Encoding.GetBytes(items[i], data.AsSpan(offsets[i]));
+    }
+
+    // The managed copy of the native items, read back from the native side first if it was reordered there.
+    private List<string> Mirror
+    {
+        get
+        {
+            if (_mirrorStale)
+                SyncFromNative();
+            return _items;
+        }
+    }
+
+    /// <summary>
+    /// Marks the managed copy of the items as out of date after the native side reordered them.
+    /// </summary>
+    internal void InvalidateMirror()
+    {
+        _mirrorStale = true;
+    }
+
+    // Where an item lands when added (excludeIndex = -1) or when it replaces item excludeIndex. Unsorted lists put
+    // it at `index` without asking the native side.
+    private int GetSortedPosition(string item, int excludeIndex, int index)
+    {
+        if (_owner.SortOrder == ListBoxSortOrder.None)
+            return index;
+        Check(NativeMethods.TfListBoxGetSortedPosition(_owner.Ptr, item, excludeIndex, out var position));
+        return position;
+    }
+
+    private void ThrowIfVirtual()
+    {
+        if (_owner.VirtualItemProvider != null)
+        {
+            throw new InvalidOperationException(
+                "Items cannot be modified while the ListBox has a VirtualItemProvider."
+            );
+        }
+    }
+
     /// <summary>
     /// Initializes the collection with items from the native side.
     /// Called during ListBox construction if items already exist.
     /// </summary>
     internal void SyncFromNative()
     {
+        _mirrorStale = false;
         _items.Clear();
         Check(NativeMethods.TfListBoxGetItemCount(_owner.Ptr, out var count));
-        for (var i = 0; i < count; i++)
+        if (count == 0)
+            return;
+
+        // Copy every item in one call rather than one call and one native allocation per item.
+        Check(NativeMethods.TfListBoxCopyItems(_owner.Ptr, 0, count, null, 0, null, out var length));
+        var data = new byte[Math.Max(length, 1)];
+        var offsets = new int[count + 1];
+        fixed (byte* dataPtr = data)
+        fixed (int* offsetsPtr = offsets)
         {
-            Check(NativeMethods.TfListBoxGetItemAt(_owner.Ptr, i, out var item));
-            _items.Add(item);
+            Check(
+                NativeMethods.TfListBoxCopyItems(
+                    _owner.Ptr,
+                    0,
+                    count,
+                    dataPtr,
+                    data.Length,
+                    offsetsPtr,
+                    out _
+                )
+            );
         }
+
+        _items.Capacity = count;
+        for (var i = 0; i < count; i++)
+            _items.Add(Global.UTF8Encoding.GetString(data, offsets[i], offsets[i + 1] - offsets[i]));
     }
 
     private static partial class NativeMethods
@@ -240,8 +450,16 @@ public unsafe partial class ListBoxItemCollection : IList<string>
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfListBoxGetItemCount(void* self, out int @out);
 
-        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
-        public static partial Error TfListBoxGetItemAt(void* self, int index, out string @out);
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxCopyItems(
+            void* self,
+            int index,
+            int count,
+            byte* data,
+            int dataSize,
+            int* offsets,
+            out int outLength
+        );
 
         [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
         public static partial Error TfListBoxSetItemAt(void* self, int index, string text);
@@ -257,5 +475,32 @@ public unsafe partial class ListBoxItemCollection : IList<string>
 
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfListBoxClearItems(void* self);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxAddItemsPacked(
+            void* self,
+            byte* data,
+            int* offsets,
+            int count
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxReplaceItemsPacked(
+            void* self,
+            byte* data,
+            int* offsets,
+            int count
+        );
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfListBoxGetSortedPosition(
+            void* self,
+            string text,
+            int excludeIndex,
+            out int @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfListBoxRemoveRange(void* self, int index, int count);
     }
 }
@@ -4,6 +4,10 @@ namespace TerminalForms;
 /// Maintains a mapping from C++ object pointers to their corresponding C# objects.
 /// This allows callbacks to make the leap from the C++ side to the correct C# object.
 /// </summary>
+/// <remarks>
+/// Most callbacks arrive on the UI thread, but some, such as <see cref="TextBox.SuggestionProvider"/>, run on
+/// native worker threads, so every access takes a lock.
+/// </remarks>
 internal static unsafe class ObjectRegistry
 {
     private static readonly Dictionary<IntPtr, WeakReference<TerminalFormsObject>> _objects = [];
@@ -21,7 +25,8 @@ internal static unsafe class ObjectRegistry
     /// </remarks>
     public static void Register(TerminalFormsObject obj)
     {
-        _objects[(IntPtr)obj.Ptr] = new WeakReference<TerminalFormsObject>(obj);
+        lock (_objects)
+            _objects[(IntPtr)obj.Ptr] = new WeakReference<TerminalFormsObject>(obj);
     }
 
     /// <summary>
@@ -35,7 +40,8 @@ internal static unsafe class ObjectRegistry
     /// </remarks>
     public static void Unregister(TerminalFormsObject obj)
     {
-        _objects.Remove((IntPtr)obj.Ptr);
+        lock (_objects)
+            _objects.Remove((IntPtr)obj.Ptr);
     }
 
     /// <summary>
@@ -59,7 +65,12 @@ internal static unsafe class ObjectRegistry
     public static bool TryGet(void* ptr, out TerminalFormsObject? @out)
     {
         @out = null;
-        return _objects.TryGetValue((IntPtr)ptr, out var weakReference)
-            && weakReference.TryGetTarget(out @out);
+        WeakReference<TerminalFormsObject>? weakReference;
+        lock (_objects)
+        {
+            if (!_objects.TryGetValue((IntPtr)ptr, out weakReference))
+                return false;
+        }
+        return weakReference.TryGetTarget(out @out);
     }
 }
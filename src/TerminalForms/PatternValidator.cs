@@ -0,0 +1,60 @@
+namespace TerminalForms;
+
+/// <summary>
+/// A <see cref="Validator"/> that accepts text matching a regular expression.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The whole text has to match, as if the pattern were anchored at both ends. The pattern is compiled into a
+/// state machine when the validator is assigned to a text box, and each keystroke then costs one table lookup
+/// per byte typed. While the text is a prefix of some match, such as <c>192.16</c> for an IP address, it can be
+/// edited freely; an edit that would leave no way to complete a match is refused.
+/// </para>
+/// <para>
+/// The syntax is a subset of .NET regular expressions: literal characters; <c>.</c> for any character;
+/// <c>\d</c>, <c>\w</c>, <c>\s</c> and their negations <c>\D</c>, <c>\W</c>, <c>\S</c>, which cover ASCII
+/// characters only; character classes such as <c>[a-z_]</c> and <c>[^,]</c>, which list ASCII characters only;
+/// groups in parentheses; <c>|</c> between alternatives; and the quantifiers <c>*</c>, <c>+</c>, <c>?</c>,
+/// <c>{n}</c>, <c>{n,}</c> and <c>{n,m}</c>, with counts up to 255. A backslash makes any other character
+/// literal. Anchors, lazy quantifiers, lookaround and backreferences are not supported.
+/// </para>
+/// </remarks>
+/// <example>
+/// <code>
+/// var octet = @"(25[0-5]|2[0-4]\d|1\d\d|[1-9]?\d)";
+/// textBox.Validator = new PatternValidator($@"({octet}\.){{3}}{octet}");
+/// </code>
+/// </example>
+public sealed unsafe partial class PatternValidator : Validator
+{
+    /// <summary>
+    /// Initializes a new instance of the <see cref="PatternValidator"/> class.
+    /// </summary>
+    /// <param name="pattern">The regular expression that the text has to match.</param>
+    /// <exception cref="ArgumentNullException"><paramref name="pattern"/> is null.</exception>
+    /// <remarks>
+    /// The pattern is checked when the validator is assigned to <see cref="TextBox.Validator"/>, which throws
+    /// <see cref="TerminalFormsException"/> describing the problem if it is malformed or too complex.
+    /// </remarks>
+    public PatternValidator(string pattern)
+    {
+        ArgumentNullException.ThrowIfNull(pattern);
+        Pattern = pattern;
+    }
+
+    /// <summary>
+    /// Gets the regular expression that the text has to match.
+    /// </summary>
+    public string Pattern { get; }
+
+    internal override void Attach(void* textBox)
+    {
+        Check(NativeMethods.TfTextBoxSetPatternValidator(textBox, Pattern));
+    }
+
+    private static partial class NativeMethods
+    {
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfTextBoxSetPatternValidator(void* self, string pattern);
+    }
+}
@@ -20,6 +20,11 @@ namespace TerminalForms;
 /// The control automatically ensures that exactly one item is selected at all times
 /// (as long as items exist). When items are added, removed, or modified, the selection
 /// is automatically adjusted to remain valid.
+///
+/// The items form a single column. When there are more items than the control is tall, the
+/// column scrolls to keep the focused item in view (Page Up, Page Down, Home and End move by
+/// larger steps), and only the items on screen are drawn. Use
+/// <see cref="RadioButtonItemCollection.AddRange"/> to load many items at once.
 /// </remarks>
 /// <example>
 /// <code>
@@ -81,11 +86,7 @@ public unsafe partial class RadioButtonGroup : Control
 
         // Clear the default item and add the provided items
         Items.Clear();
-        foreach (var item in items)
-        {
-            ArgumentNullException.ThrowIfNull(item);
-            Items.Add(item);
-        }
+        Items.AddRange(items);
     }
 
     /// <summary>
@@ -204,6 +205,25 @@ public unsafe partial class RadioButtonGroup : Control
         }
     }
 
+    /// <summary>
+    /// Gets the number of screen cells this control has drawn since it was created.
+    /// </summary>
+    /// <value>A running total of the cells written, including every full redraw.</value>
+    /// <remarks>
+    /// Changing the selection repaints only the lines holding the old and new marks, and replacing or
+    /// adding an item repaints only its line, unless the change scrolls the items. Items off screen are
+    /// not drawn. Compare the value before and after a change to see how much of the control it repainted.
+    /// </remarks>
+    public long CellsWritten
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfRadioButtonGroupGetCellsWritten(Ptr, out var value));
+            return value;
+        }
+    }
+
     #region SelectedIndexChanged
 
     [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
@@ -277,5 +297,8 @@ public unsafe partial class RadioButtonGroup : Control
 
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfRadioButtonGroupSetSelectedIndex(void* self, int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfRadioButtonGroupGetCellsWritten(void* self, out long @out);
     }
 }
@@ -5,7 +5,7 @@ namespace TerminalForms;
 /// <summary>
 /// Represents a collection of string items in a <see cref="RadioButtonGroup"/> control.
 /// This collection maintains synchronization between the managed list and the native
-/// Turbo Vision string collection.
+/// item storage.
 /// </summary>
 /// <remarks>
 /// The collection supports standard list operations such as adding, removing, and modifying items.
@@ -83,6 +83,40 @@ public unsafe partial class RadioButtonItemCollection : IList<string>
         Check(NativeMethods.TfRadioButtonGroupAddItem(_owner.Ptr, item));
     }
 
+    /// <summary>
+    /// Adds several items to the end of the collection in a single update.
+    /// </summary>
+    /// <param name="items">The strings to add to the collection.</param>
+    /// <exception cref="ArgumentNullException">
+    /// <paramref name="items"/> is null, or any item in it is null.
+    /// </exception>
+    /// <remarks>
+    /// This is much faster than calling <see cref="Add"/> in a loop for large numbers of items:
+    /// the items cross to the native side in one call and the group is redrawn once. The
+    /// selection does not change.
+    /// </remarks>
+    public void AddRange(IEnumerable<string> items)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        var array = ListBoxItemCollection.ToCheckedArray(items);
+        if (array.Length == 0)
+            return;
+        ListBoxItemCollection.PackItems(array, out var data, out var offsets);
+        _items.AddRange(array);
+        fixed (byte* dataPtr = data)
+        fixed (int* offsetsPtr = offsets)
+        {
+            Check(
+                NativeMethods.TfRadioButtonGroupAddItemsPacked(
+                    _owner.Ptr,
+                    dataPtr,
+                    offsetsPtr,
+                    array.Length
+                )
+            );
+        }
+    }
+
     /// <summary>
     /// Removes all items from the collection.
     /// </summary>
@@ -255,6 +289,14 @@ public unsafe partial class RadioButtonItemCollection : IList<string>
             string text
         );
 
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfRadioButtonGroupAddItemsPacked(
+            void* self,
+            byte* data,
+            int* offsets,
+            int count
+        );
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfRadioButtonGroupRemoveItemAt(void* self, int index);
 
@@ -0,0 +1,49 @@
+namespace TerminalForms;
+
+/// <summary>
+/// A <see cref="Validator"/> that accepts a whole number within a range.
+/// </summary>
+/// <remarks>
+/// The text has to be decimal digits with an optional leading minus sign. A keystroke is refused when no
+/// further digits could bring the number into range: with a range of 20 to 25, typing <c>3</c> is refused
+/// because 3 is too small and every longer number starting with 3 is too large. The number is tracked as it is
+/// typed, so checking a keystroke does not parse or allocate anything.
+/// </remarks>
+public sealed unsafe partial class RangeValidator : Validator
+{
+    /// <summary>
+    /// Initializes a new instance of the <see cref="RangeValidator"/> class.
+    /// </summary>
+    /// <param name="minimum">The smallest number accepted.</param>
+    /// <param name="maximum">The largest number accepted.</param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="maximum"/> is less than <paramref name="minimum"/>.
+    /// </exception>
+    public RangeValidator(long minimum, long maximum)
+    {
+        ArgumentOutOfRangeException.ThrowIfLessThan(maximum, minimum);
+        Minimum = minimum;
+        Maximum = maximum;
+    }
+
+    /// <summary>
+    /// Gets the smallest number accepted.
+    /// </summary>
+    public long Minimum { get; }
+
+    /// <summary>
+    /// Gets the largest number accepted.
+    /// </summary>
+    public long Maximum { get; }
+
+    internal override void Attach(void* textBox)
+    {
+        Check(NativeMethods.TfTextBoxSetRangeValidator(textBox, Minimum, Maximum));
+    }
+
+    private static partial class NativeMethods
+    {
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSetRangeValidator(void* self, long minimum, long maximum);
+    }
+}
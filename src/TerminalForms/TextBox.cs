@@ -20,9 +20,19 @@ public unsafe partial class TextBox : Control
         NativeMethods.TfTextBoxHash
     );
 
+    // The last text read and the edit generation it was read at. Reading Text again before the next edit
+    // returns the same string without copying it out of the native buffer.
+    private string? _text;
+    private ulong _textGeneration;
+
+    private Validator? _validator;
+    private TextBoxHistory? _history;
+    private volatile Func<string, IEnumerable<string>>? _suggestionProvider;
+    private ListBox? _suggestionList;
+
     /// <summary>
     /// Initializes a new instance of the <see cref="TextBox"/> class.
-    /// Creates a text input control with a default maximum length of 256 characters.
+    /// Creates a text input control with a default <see cref="MaxLength"/> of 256.
     /// </summary>
     /// <remarks>
     /// The text box is initially empty and enabled. Users can type text, use arrow keys
@@ -39,6 +49,14 @@ public unsafe partial class TextBox : Control
                 Ptr
             )
         );
+        Check(NativeMethods.TfTextBoxSetPasteEventHandler(Ptr, &NativePasteEventHandler, Ptr));
+        Check(
+            NativeMethods.TfTextBoxSetSuggestionsReadyEventHandler(
+                Ptr,
+                &NativeSuggestionsReadyEventHandler,
+                Ptr
+            )
+        );
     }
 
     #region Text Property
@@ -58,8 +76,14 @@ public unsafe partial class TextBox : Control
         get
         {
             ObjectDisposedException.ThrowIf(IsDisposed, this);
-            Check(NativeMethods.TfTextBoxGetText(Ptr, out var text));
-            return text;
+            Check(NativeMethods.TfTextBoxGetEditGeneration(Ptr, out var generation));
+            if (_text is null || generation != _textGeneration)
+            {
+                Check(NativeMethods.TfTextBoxGetText(Ptr, out var text));
+                _text = text;
+                _textGeneration = generation;
+            }
+            return _text;
         }
         set
         {
@@ -73,17 +97,22 @@ public unsafe partial class TextBox : Control
     #region MaxLength Property
 
     /// <summary>
-    /// Gets the maximum number of characters that can be entered into the text box.
+    /// Gets or sets the maximum number of bytes of UTF-8 text that can be entered into the text box.
     /// </summary>
     /// <value>
-    /// The maximum number of characters that can be entered in the control. The default is 256.
-    /// This value is set when the control is created and cannot be changed afterward.
+    /// The maximum length of the text in UTF-8 bytes, which is the number of characters for ASCII text.
+    /// The default is 256.
     /// </value>
+    /// <exception cref="ArgumentOutOfRangeException">The value is less than 0.</exception>
     /// <remarks>
     /// The MaxLength property enforces a hard limit on text entry. When the limit is reached,
     /// the control will not accept additional characters from keyboard input or paste operations.
     /// Attempting to set the <see cref="Text"/> property with a string longer than MaxLength will
     /// result in the string being truncated.
+    ///
+    /// The limit can be changed at any time. Storage grows with the text rather than with the limit,
+    /// so a large MaxLength costs nothing until the text is actually that long. Lowering MaxLength below
+    /// the current length truncates the text, which raises <see cref="TextChanged"/>.
     /// </remarks>
     public int MaxLength
     {
@@ -93,6 +122,220 @@ public unsafe partial class TextBox : Control
             Check(NativeMethods.TfTextBoxGetMaxLength(Ptr, out var value));
             return value;
         }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            ArgumentOutOfRangeException.ThrowIfNegative(value);
+            Check(NativeMethods.TfTextBoxSetMaxLength(Ptr, value));
+        }
+    }
+
+    #endregion
+
+    #region Validator Property
+
+    /// <summary>
+    /// Gets or sets the validator that restricts what can be entered in the text box.
+    /// </summary>
+    /// <value>
+    /// A <see cref="PatternValidator"/>, a <see cref="RangeValidator"/>, or null to accept any text. The default
+    /// is null.
+    /// </value>
+    /// <exception cref="TerminalFormsException">
+    /// The value is a <see cref="PatternValidator"/> whose pattern is malformed or too complex.
+    /// </exception>
+    /// <remarks>
+    /// The validator applies to the user's typing, deleting, cutting and pasting. Each edit is checked natively
+    /// as it happens, resuming from the state already reached for the text before the edit, so typing at the end
+    /// of the text costs only the new characters. An edit that would leave text no further typing could make
+    /// valid is refused without raising <see cref="TextChanged"/>.
+    ///
+    /// Text assigned through <see cref="Text"/> or <see cref="SelectedText"/> is not checked; use
+    /// <see cref="IsInputValid"/> to find out whether it is valid. While it is invalid, the user's edits are
+    /// only refused if they would make it invalid for good.
+    /// </remarks>
+    public Validator? Validator
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            return _validator;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (value is null)
+                Check(NativeMethods.TfTextBoxClearValidator(Ptr));
+            else
+                value.Attach(Ptr);
+            _validator = value;
+        }
+    }
+
+    /// <summary>
+    /// Gets a value indicating whether the text is complete and valid according to <see cref="Validator"/>.
+    /// </summary>
+    /// <value>
+    /// true if the text is accepted by <see cref="Validator"/> or there is no validator; false if the text is
+    /// incomplete or invalid, such as <c>192.168</c> when an IP address is expected.
+    /// </value>
+    public bool IsInputValid
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfTextBoxGetInputValid(Ptr, out var value));
+            return value;
+        }
+    }
+
+    #endregion
+
+    #region History Property
+
+    /// <summary>
+    /// Gets the text previously entered in the text box.
+    /// </summary>
+    /// <value>
+    /// The history, newest first. It keeps nothing until <see cref="TextBoxHistory.Capacity"/> is set.
+    /// </value>
+    /// <remarks>
+    /// The text is added to the history when the text box loses the focus. Pressing Up replaces the text with
+    /// the newest entry that starts with what had been typed, and pressing it again with the next newest;
+    /// Down steps back, ending at the typed text. Each recalled entry raises <see cref="TextChanged"/>.
+    /// </remarks>
+    public TextBoxHistory History
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            return _history ??= new TextBoxHistory(this);
+        }
+    }
+
+    #endregion
+
+    #region Suggestions
+
+    /// <summary>
+    /// Gets or sets the function that looks up suggestions for the text.
+    /// </summary>
+    /// <value>
+    /// A function that takes the text and returns the suggestions for it, or null for no suggestions. The
+    /// default is null.
+    /// </value>
+    /// <remarks>
+    /// The function runs on a background thread, not the UI thread, so it may take its time without holding up
+    /// typing; it must not touch controls. Each change to the text requests a new lookup. Lookups run one at a
+    /// time, and a request that is overtaken by another before its lookup starts is skipped, so a fast typist
+    /// costs one lookup per pause rather than one per key.
+    ///
+    /// Results for anything but the newest text are discarded. The newest are shown in
+    /// <see cref="SuggestionList"/>, replacing its items in a single update on the UI thread.
+    ///
+    /// Setting this property waits for a lookup in progress to finish.
+    /// </remarks>
+    public Func<string, IEnumerable<string>>? SuggestionProvider
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            return _suggestionProvider;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (value is null)
+                Check(NativeMethods.TfTextBoxSetSuggestionProvider(Ptr, null, null));
+            else
+                Check(NativeMethods.TfTextBoxSetSuggestionProvider(Ptr, &NativeSuggestionFunction, Ptr));
+            _suggestionProvider = value;
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets the list box that shows the suggestions from <see cref="SuggestionProvider"/>.
+    /// </summary>
+    /// <value>
+    /// The list box whose items are replaced by each new set of suggestions, or null. The default is null.
+    /// </value>
+    /// <remarks>
+    /// A list box in virtual mode, or one that has been disposed, is left alone.
+    /// </remarks>
+    public ListBox? SuggestionList
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            return _suggestionList;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            _suggestionList = value;
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativeSuggestionFunction(void* userData, ulong generation, byte* text)
+    {
+        // Runs on the native worker thread.
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return;
+
+            var textBox = (TextBox)obj!;
+            var provider = textBox._suggestionProvider;
+            if (textBox.IsDisposed || provider is null)
+                return;
+
+            var suggestions = ListBoxItemCollection.ToCheckedArray(
+                provider(Marshal.PtrToStringUTF8((IntPtr)text) ?? string.Empty)
+            );
+            ListBoxItemCollection.PackItems(suggestions, out var data, out var offsets);
+            fixed (byte* dataPtr = data)
+            fixed (int* offsetsPtr = offsets)
+            {
+                NativeMethods.TfTextBoxSubmitSuggestions(
+                    textBox.Ptr,
+                    generation,
+                    dataPtr,
+                    offsetsPtr,
+                    suggestions.Length,
+                    out _
+                );
+            }
+        }
+        catch { }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativeSuggestionsReadyEventHandler(void* userData)
+    {
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return;
+
+            var textBox = (TextBox)obj!;
+            ObjectDisposedException.ThrowIf(textBox.IsDisposed, textBox);
+            var list = textBox._suggestionList;
+            if (list is not null && list.IsDisposed)
+                list = null;
+
+            // Without a list box, this still takes the results, so they are not kept around.
+            Check(
+                NativeMethods.TfTextBoxApplySuggestions(
+                    textBox.Ptr,
+                    list is null ? null : list.Ptr,
+                    out var applied
+                )
+            );
+            if (applied)
+                list!.Items.InvalidateMirror();
+        }
+        catch { }
     }
 
     #endregion
@@ -107,6 +350,10 @@ public unsafe partial class TextBox : Control
     /// Valid values range from 0 to the length of the text. Out-of-range values are automatically clamped.
     /// </value>
     /// <remarks>
+    /// Selection positions and lengths count user-perceived characters (grapheme clusters), the text elements
+    /// that <see cref="System.Globalization.StringInfo"/> enumerates, not <see cref="char"/> values. A letter
+    /// with combining accents, an emoji with a skin tone modifier, or a flag counts as one character, so a
+    /// selection can never split one.
     /// Use this property in conjunction with <see cref="SelectionLength"/> to programmatically control
     /// text selection. Setting SelectionStart maintains the current SelectionLength if possible.
     /// If the selection would exceed the text bounds, the length is automatically adjusted.
@@ -173,22 +420,25 @@ public unsafe partial class TextBox : Control
         {
             ObjectDisposedException.ThrowIf(IsDisposed, this);
 
-            // Get selection length first to size the buffer
-            Check(NativeMethods.TfTextBoxGetSelectionLength(Ptr, out var length));
+            // Get the selected text's length in bytes first to size the buffer
+            Check(NativeMethods.TfTextBoxGetSelectedTextLength(Ptr, out var length));
             if (length == 0)
                 return string.Empty;
 
-            // Allocate buffer and retrieve selected text (+1 for null terminator)
+            // Allocate buffer and retrieve selected text (+1 for null terminator). Long selections go on the heap.
             var bufferSize = length + 1;
-            var buffer = stackalloc byte[bufferSize];
-            Check(NativeMethods.TfTextBoxGetSelectedText(Ptr, buffer, bufferSize));
+            Span<byte> span = bufferSize <= 1024 ? stackalloc byte[bufferSize] : new byte[bufferSize];
+            fixed (byte* buffer = span)
+            {
+                Check(NativeMethods.TfTextBoxGetSelectedText(Ptr, buffer, bufferSize));
+            }
 
             // Find actual length (null-terminated)
             var actualLength = 0;
-            while (actualLength < length && buffer[actualLength] != 0)
+            while (actualLength < length && span[actualLength] != 0)
                 actualLength++;
 
-            return Global.UTF8Encoding.GetString(buffer, actualLength);
+            return Global.UTF8Encoding.GetString(span[..actualLength]);
         }
         set
         {
@@ -214,6 +464,7 @@ public unsafe partial class TextBox : Control
     /// greater than the text length, it is set to the text length. If the length parameter is
     /// negative, it is set to zero. If the length would extend beyond the end of the text,
     /// it is reduced to select to the end of the text.
+    /// Both parameters count user-perceived characters, as <see cref="SelectionStart"/> describes.
     /// </remarks>
     public void Select(int start, int length)
     {
@@ -249,6 +500,24 @@ public unsafe partial class TextBox : Control
         Check(NativeMethods.TfTextBoxClear(Ptr));
     }
 
+    /// <summary>
+    /// Replaces the selection with the specified text, as if the user had pasted it.
+    /// </summary>
+    /// <param name="text">The text to insert.</param>
+    /// <exception cref="ArgumentNullException"><paramref name="text"/> is null.</exception>
+    /// <remarks>
+    /// The text is inserted as a single edit, however long it is: the text box is redrawn once and
+    /// <see cref="TextChanged"/> is raised once. Line breaks, tabs and other control characters become spaces,
+    /// since the text box holds a single line. Unlike setting <see cref="SelectedText"/>, the edit is refused
+    /// if <see cref="Validator"/> rejects it. <see cref="Pasting"/> is not raised.
+    /// </remarks>
+    public void Paste(string text)
+    {
+        ObjectDisposedException.ThrowIf(IsDisposed, this);
+        ArgumentNullException.ThrowIfNull(text);
+        Check(NativeMethods.TfTextBoxPaste(Ptr, text));
+    }
+
     #endregion
 
     #region TextChanged Event
@@ -294,6 +563,57 @@ public unsafe partial class TextBox : Control
 
     #endregion
 
+    #region Pasting Event
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static int NativePasteEventHandler(void* userData, byte* text, int length)
+    {
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return 0;
+
+            var textBox = (TextBox)obj!;
+            ObjectDisposedException.ThrowIf(textBox.IsDisposed, textBox);
+            if (textBox.Pasting is null)
+                return 0;
+            var e = new TextBoxPasteEventArgs(Global.UTF8Encoding.GetString(text, length));
+            textBox.OnPasting(e);
+            return e.Handled ? 1 : 0;
+        }
+        catch
+        {
+            return 0;
+        }
+    }
+
+    /// <summary>
+    /// Occurs when the user pastes text, before the text box inserts it.
+    /// </summary>
+    /// <remarks>
+    /// A paste from the clipboard or from the terminal arrives natively as one key event per character. The
+    /// text box gathers them and raises this event once with the whole text, then inserts it as a single edit
+    /// with one redraw and one <see cref="TextChanged"/>. Set <see cref="TextBoxPasteEventArgs.Handled"/> to
+    /// take the text instead; for example, to spread multi-line text over several fields, or to clean it up
+    /// and insert it with <see cref="Paste"/>.
+    /// </remarks>
+    public event EventHandler<TextBoxPasteEventArgs>? Pasting;
+
+    /// <summary>
+    /// Raises the <see cref="Pasting"/> event.
+    /// </summary>
+    /// <param name="e">The event data.</param>
+    /// <remarks>
+    /// When overriding this method in a derived class, be sure to call the base implementation
+    /// to ensure that registered event handlers are invoked.
+    /// </remarks>
+    protected virtual void OnPasting(TextBoxPasteEventArgs e)
+    {
+        Pasting?.Invoke(this, e);
+    }
+
+    #endregion
+
     #region NativeMethods
 
     private static partial class NativeMethods
@@ -320,9 +640,24 @@ public unsafe partial class TextBox : Control
         [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
         public static partial Error TfTextBoxSetText(void* self, string text);
 
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxGetEditGeneration(void* self, out ulong @out);
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfTextBoxGetMaxLength(void* self, out int @out);
 
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSetMaxLength(void* self, int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxClearValidator(void* self);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxGetInputValid(
+            void* self,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfTextBoxGetSelectionStart(void* self, out int @out);
 
@@ -335,6 +670,9 @@ public unsafe partial class TextBox : Control
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfTextBoxSetSelectionLength(void* self, int value);
 
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxGetSelectedTextLength(void* self, out int @out);
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfTextBoxGetSelectedText(
             void* self,
@@ -354,12 +692,53 @@ public unsafe partial class TextBox : Control
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfTextBoxClear(void* self);
 
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfTextBoxPaste(void* self, string text);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSetSuggestionProvider(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, ulong, byte*, void> function,
+            void* userData
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSetSuggestionsReadyEventHandler(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, void> function,
+            void* userData
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSubmitSuggestions(
+            void* self,
+            ulong generation,
+            byte* data,
+            int* offsets,
+            int count,
+            [MarshalAs(UnmanagedType.I4)] out bool accepted
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxApplySuggestions(
+            void* self,
+            void* list,
+            [MarshalAs(UnmanagedType.I4)] out bool applied
+        );
+
         [LibraryImport(Global.DLL_NAME)]
         public static partial Error TfTextBoxSetTextChangedEventHandler(
             void* self,
             delegate* unmanaged[Cdecl]<void*, void> function,
             void* userData
         );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSetPasteEventHandler(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, byte*, int, int> function,
+            void* userData
+        );
     }
 
     #endregion
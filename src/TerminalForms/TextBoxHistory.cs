@@ -0,0 +1,239 @@
+using System.Collections;
+
+namespace TerminalForms;
+
+/// <summary>
+/// Represents the text previously entered in a <see cref="TextBox"/>, newest first.
+/// </summary>
+/// <remarks>
+/// The history is off until <see cref="Capacity"/> is set. After that, the text is added each time the text
+/// box loses the focus, and the user can press Up and Down to step through the entries that start with what
+/// they had typed. Adding text that is already in the history moves it to the front rather than adding it
+/// twice.
+///
+/// The entries are kept natively in a ring of <see cref="Capacity"/> bytes, so the history never grows past
+/// it: adding an entry that does not fit drops the oldest ones. A sorted index finds the entries with a given
+/// prefix with a binary search, however many there are; see <see cref="GetSuggestions"/>.
+///
+/// <see cref="OpenFile"/> moves the ring into a memory-mapped file, so the history survives from one run of
+/// the application to the next. Opening the file again at startup maps it as it is, without reading or
+/// parsing the entries.
+/// </remarks>
+/// <example>
+/// <code>
+/// var textBox = new TextBox();
+/// textBox.History.Capacity = 4096;
+/// textBox.History.OpenFile(Path.Combine(dataDirectory, "search.history"));
+///
+/// foreach (var index in textBox.History.GetSuggestions("ter", 5))
+///     Console.WriteLine(textBox.History[index]);
+/// </code>
+/// </example>
+public unsafe partial class TextBoxHistory : IReadOnlyList<string>
+{
+    private readonly TextBox _owner;
+
+    internal TextBoxHistory(TextBox owner)
+    {
+        _owner = owner;
+    }
+
+    /// <summary>
+    /// Gets or sets the number of bytes the history may use.
+    /// </summary>
+    /// <value>
+    /// The size of the history in bytes. Each entry takes its UTF-8 length plus up to 12 bytes. The default is
+    /// 0, which keeps no history.
+    /// </value>
+    /// <exception cref="ArgumentOutOfRangeException">The value is less than 0.</exception>
+    /// <remarks>
+    /// Changing the capacity keeps the newest entries that fit. While a file is open, the file is resized.
+    /// </remarks>
+    public int Capacity
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+            Check(NativeMethods.TfTextBoxGetHistoryCapacity(_owner.Ptr, out var value));
+            return value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+            ArgumentOutOfRangeException.ThrowIfNegative(value);
+            Check(NativeMethods.TfTextBoxSetHistoryCapacity(_owner.Ptr, value));
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of entries in the history.
+    /// </summary>
+    public int Count
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+            Check(NativeMethods.TfTextBoxGetHistoryCount(_owner.Ptr, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Gets the entry at the specified index.
+    /// </summary>
+    /// <param name="index">The zero-based index of the entry, where 0 is the newest.</param>
+    /// <returns>The entry at the specified index.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// <paramref name="index"/> is less than 0 or greater than or equal to <see cref="Count"/>.
+    /// </exception>
+    public string this[int index]
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+            if (index < 0 || index >= Count)
+                throw new ArgumentOutOfRangeException(nameof(index));
+            Check(NativeMethods.TfTextBoxGetHistoryItem(_owner.Ptr, index, out var value));
+            return value;
+        }
+    }
+
+    /// <summary>
+    /// Adds text to the front of the history.
+    /// </summary>
+    /// <param name="text">The text to add.</param>
+    /// <exception cref="ArgumentNullException"><paramref name="text"/> is null.</exception>
+    /// <remarks>
+    /// Text already in the history moves to the front. Empty text, and text too long to fit in
+    /// <see cref="Capacity"/>, is ignored.
+    /// </remarks>
+    public void Add(string text)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ArgumentNullException.ThrowIfNull(text);
+        Check(NativeMethods.TfTextBoxAddHistory(_owner.Ptr, text));
+    }
+
+    /// <summary>
+    /// Removes all entries from the history, and from its file if one is open.
+    /// </summary>
+    public void Clear()
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        Check(NativeMethods.TfTextBoxClearHistory(_owner.Ptr));
+    }
+
+    /// <summary>
+    /// Finds the newest entries that start with the specified text.
+    /// </summary>
+    /// <param name="prefix">The text the entries must start with. An empty string matches every entry.</param>
+    /// <param name="maxCount">The most indexes to return.</param>
+    /// <returns>The indexes of the matching entries, newest first.</returns>
+    /// <exception cref="ArgumentNullException"><paramref name="prefix"/> is null.</exception>
+    /// <exception cref="ArgumentOutOfRangeException"><paramref name="maxCount"/> is less than 0.</exception>
+    /// <remarks>
+    /// The comparison is by UTF-8 bytes, so it is case-sensitive. The cost depends on the length of the prefix
+    /// and the number of matches, not on the number of entries.
+    /// </remarks>
+    public int[] GetSuggestions(string prefix, int maxCount)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ArgumentNullException.ThrowIfNull(prefix);
+        ArgumentOutOfRangeException.ThrowIfNegative(maxCount);
+        var indexes = new int[Math.Min(maxCount, Count)];
+        int count;
+        fixed (int* indexesPtr = indexes)
+        {
+            Check(
+                NativeMethods.TfTextBoxFindHistory(
+                    _owner.Ptr,
+                    prefix,
+                    indexesPtr,
+                    indexes.Length,
+                    out count
+                )
+            );
+        }
+        return count == indexes.Length ? indexes : indexes[..count];
+    }
+
+    /// <summary>
+    /// Keeps the history in the specified file from now on.
+    /// </summary>
+    /// <param name="path">The path of the history file. It is created if it does not exist.</param>
+    /// <exception cref="ArgumentNullException"><paramref name="path"/> is null.</exception>
+    /// <exception cref="TerminalFormsException">The file cannot be opened or mapped into memory.</exception>
+    /// <remarks>
+    /// If the file holds a history, its entries and capacity replace the current ones. Otherwise the file is
+    /// overwritten with the current entries, sized for the current <see cref="Capacity"/>. From then on every
+    /// change goes straight to the file, which is memory-mapped; there is nothing to save.
+    ///
+    /// The file is closed when the text box is disposed or <see cref="CloseFile"/> is called. Only one text
+    /// box should have a given file open at a time.
+    /// </remarks>
+    public void OpenFile(string path)
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        ArgumentNullException.ThrowIfNull(path);
+        Check(NativeMethods.TfTextBoxOpenHistoryFile(_owner.Ptr, path));
+    }
+
+    /// <summary>
+    /// Closes the history file, keeping the entries in memory. Does nothing if no file is open.
+    /// </summary>
+    public void CloseFile()
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        Check(NativeMethods.TfTextBoxCloseHistoryFile(_owner.Ptr));
+    }
+
+    /// <summary>
+    /// Returns an enumerator that iterates through the history, newest first.
+    /// </summary>
+    /// <returns>An enumerator for the history.</returns>
+    public IEnumerator<string> GetEnumerator()
+    {
+        ObjectDisposedException.ThrowIf(_owner.IsDisposed, _owner);
+        var count = Count;
+        for (var i = 0; i < count; i++)
+            yield return this[i];
+    }
+
+    IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+
+    private static partial class NativeMethods
+    {
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxGetHistoryCapacity(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxSetHistoryCapacity(void* self, int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxGetHistoryCount(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfTextBoxGetHistoryItem(void* self, int index, out string @out);
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfTextBoxAddHistory(void* self, string text);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxClearHistory(void* self);
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfTextBoxFindHistory(
+            void* self,
+            string prefix,
+            int* indexes,
+            int maxCount,
+            out int count
+        );
+
+        [LibraryImport(Global.DLL_NAME, StringMarshalling = StringMarshalling.Utf8)]
+        public static partial Error TfTextBoxOpenHistoryFile(void* self, string path);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTextBoxCloseHistoryFile(void* self);
+    }
+}
@@ -0,0 +1,30 @@
+namespace TerminalForms;
+
+/// <summary>
+/// Provides data for the <see cref="TextBox.Pasting"/> event.
+/// </summary>
+public class TextBoxPasteEventArgs : EventArgs
+{
+    /// <summary>
+    /// Initializes a new instance of the <see cref="TextBoxPasteEventArgs"/> class.
+    /// </summary>
+    /// <param name="text">The pasted text.</param>
+    public TextBoxPasteEventArgs(string text)
+    {
+        Text = text;
+    }
+
+    /// <summary>
+    /// Gets the pasted text, exactly as it arrived, including any line breaks.
+    /// </summary>
+    public string Text { get; }
+
+    /// <summary>
+    /// Gets or sets a value indicating whether the handler has dealt with the text.
+    /// </summary>
+    /// <value>
+    /// true to stop the text box from inserting the text; false to let it insert the text as usual. The
+    /// default is false.
+    /// </value>
+    public bool Handled { get; set; }
+}
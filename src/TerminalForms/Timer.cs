@@ -0,0 +1,186 @@
+using System.Runtime.CompilerServices;
+
+namespace TerminalForms;
+
+/// <summary>
+/// Raises an event at a regular interval on the UI thread.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Timers are kept natively in a hierarchical timing wheel, so starting and stopping one takes the same time
+/// however many there are. The event loop sleeps until the next timer is due instead of polling, and the
+/// <see cref="Tick"/> events of all the timers that are due run together in one batch.
+/// </para>
+/// <para>
+/// Due times are rounded up to a multiple of <see cref="Application.TimerSlack"/>, so a timer may tick up to that
+/// many milliseconds late, but never early. A tick that is missed while the UI thread is busy is not made up;
+/// the timer keeps to its schedule from the next one.
+/// </para>
+/// <para>
+/// While enabled, a timer is kept alive by the application, even if nothing else refers to it.
+/// </para>
+/// </remarks>
+public unsafe partial class Timer : TerminalFormsObject
+{
+    private static readonly MetaObject _metaObject = new(
+        NativeMethods.TfTimerNew,
+        NativeMethods.TfTimerDelete,
+        NativeMethods.TfTimerEquals,
+        NativeMethods.TfTimerHash
+    );
+
+    private static readonly HashSet<Timer> _enabledTimers = new(ReferenceEqualityComparer.Instance);
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="Timer"/> class. The timer is disabled, with an
+    /// <see cref="Interval"/> of 100 milliseconds.
+    /// </summary>
+    public Timer()
+        : base(_metaObject)
+    {
+        Check(NativeMethods.TfTimerSetTickEventHandler(Ptr, &NativeTickEventHandler, Ptr));
+    }
+
+    /// <summary>
+    /// Gets or sets the time between ticks, in milliseconds.
+    /// </summary>
+    /// <value>The time between ticks, in milliseconds. The default is 100.</value>
+    /// <exception cref="ArgumentOutOfRangeException">The value is less than 1.</exception>
+    /// <remarks>
+    /// Changing the interval of an enabled timer starts the countdown to the next tick again.
+    /// </remarks>
+    public int Interval
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfTimerGetInterval(Ptr, out var value));
+            return value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            ArgumentOutOfRangeException.ThrowIfLessThan(value, 1);
+            Check(NativeMethods.TfTimerSetInterval(Ptr, value));
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets a value indicating whether the timer is running.
+    /// </summary>
+    /// <value><see langword="true"/> if the timer raises <see cref="Tick"/>; otherwise, <see langword="false"/>.</value>
+    /// <remarks>
+    /// Enabling a disabled timer starts the countdown to the first tick. Enabling a timer that is already enabled
+    /// does nothing.
+    /// </remarks>
+    public bool Enabled
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfTimerGetEnabled(Ptr, out var value));
+            return value;
+        }
+        set
+        {
+            ObjectDisposedException.ThrowIf(IsDisposed, this);
+            Check(NativeMethods.TfTimerSetEnabled(Ptr, value));
+            if (value)
+                _enabledTimers.Add(this);
+            else
+                _enabledTimers.Remove(this);
+        }
+    }
+
+    /// <summary>
+    /// Starts the timer. This is the same as setting <see cref="Enabled"/> to <see langword="true"/>.
+    /// </summary>
+    public void Start() => Enabled = true;
+
+    /// <summary>
+    /// Stops the timer. This is the same as setting <see cref="Enabled"/> to <see langword="false"/>.
+    /// </summary>
+    public void Stop() => Enabled = false;
+
+    /// <inheritdoc/>
+    protected override void Dispose(bool disposing)
+    {
+        if (disposing)
+            _enabledTimers.Remove(this);
+        base.Dispose(disposing);
+    }
+
+    #region Tick
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void NativeTickEventHandler(void* userData)
+    {
+        try
+        {
+            if (!ObjectRegistry.TryGet(userData, out var obj))
+                return;
+
+            var timer = (Timer)obj!;
+            ObjectDisposedException.ThrowIf(timer.IsDisposed, timer);
+            timer.OnTick();
+        }
+        catch { }
+    }
+
+    /// <summary>
+    /// Occurs when the interval has elapsed and the timer is enabled.
+    /// </summary>
+    public event EventHandler? Tick;
+
+    /// <summary>
+    /// Raises the <see cref="Tick"/> event.
+    /// </summary>
+    protected virtual void OnTick()
+    {
+        Tick?.Invoke(this, EventArgs.Empty);
+    }
+    #endregion
+
+    private static partial class NativeMethods
+    {
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerNew(out void* @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerDelete(void* self);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerEquals(
+            void* self,
+            void* other,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerHash(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerGetInterval(void* self, out int @out);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerSetInterval(void* self, int value);
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerGetEnabled(
+            void* self,
+            [MarshalAs(UnmanagedType.I4)] out bool @out
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerSetEnabled(
+            void* self,
+            [MarshalAs(UnmanagedType.I4)] bool value
+        );
+
+        [LibraryImport(Global.DLL_NAME)]
+        public static partial Error TfTimerSetTickEventHandler(
+            void* self,
+            delegate* unmanaged[Cdecl]<void*, void> function,
+            void* userData
+        );
+    }
+}
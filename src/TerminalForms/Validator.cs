@@ -0,0 +1,20 @@
+namespace TerminalForms;
+
+/// <summary>
+/// Restricts the text that can be entered in a <see cref="TextBox"/>.
+/// </summary>
+/// <remarks>
+/// Assign a validator to <see cref="TextBox.Validator"/>. It is checked natively on every keystroke, with no
+/// call into managed code: an edit that would leave text no further typing could make valid is refused, and
+/// <see cref="TextBox.IsInputValid"/> tells whether the text is complete. Validators are immutable, so one
+/// instance can be shared by any number of text boxes.
+/// </remarks>
+public abstract unsafe class Validator
+{
+    private protected Validator() { }
+
+    /// <summary>
+    /// Compiles this validator and attaches it to the native text box.
+    /// </summary>
+    internal abstract void Attach(void* textBox);
+}
@@ -0,0 +1,32 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.Applications;
+
+public class ApplicationBeginInvokeDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+
+        Label label = new() { Bounds = new(1, 1, 18, 1), Text = "Posted: 0" };
+        form.Controls.Add(label);
+        form.Show();
+
+        // A worker thread hands each update to the UI thread. They queue up until the event loop starts, then run
+        // in order in one batch.
+        var count = 0;
+        var worker = new Thread(() =>
+        {
+            for (var i = 0; i < 100; i++)
+            {
+                Application.BeginInvoke(() =>
+                {
+                    count++;
+                    label.Text = $"Posted: {count}";
+                });
+            }
+        });
+        worker.Start();
+        worker.Join();
+    }
+}
@@ -0,0 +1,27 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.Applications;
+
+public class ApplicationDeferredDrawingDemo : IDemo
+{
+    public void Setup()
+    {
+        Application.DeferredDrawing = true;
+
+        Form form = new();
+
+        Label label = new() { Bounds = new(1, 1, 18, 1), Text = "Count: 0" };
+        Label stats = new() { Bounds = new(1, 2, 18, 1) };
+        form.Controls.Add(label);
+        form.Controls.Add(stats);
+        form.Show();
+
+        // Forty changes only mark the label; the frame draws it once.
+        for (var i = 1; i <= 40; i++)
+            label.Text = $"Count: {i}";
+        Application.FlushFrame();
+
+        var counters = Application.GetFrameCounters();
+        stats.Text = $"{counters.Invalidations} set, {counters.Draws} drawn";
+    }
+}
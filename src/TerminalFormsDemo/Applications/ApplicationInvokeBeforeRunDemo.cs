@@ -0,0 +1,25 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.Applications;
+
+public class ApplicationInvokeBeforeRunDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+
+        Label requiredLabel = new()
+        {
+            Bounds = new(1, 1, 18, 1),
+            Text = $"Required: {Application.InvokeRequired}",
+        };
+        Label invokedLabel = new() { Bounds = new(1, 2, 18, 1), Text = "Invoked: no" };
+        form.Controls.Add(requiredLabel);
+        form.Controls.Add(invokedLabel);
+        form.Show();
+
+        // The event loop has not started yet, but this is the UI thread, so the method runs at once instead of
+        // waiting for a loop that can only start after Setup() returns.
+        Application.Invoke(() => invokedLabel.Text = "Invoked: yes");
+    }
+}
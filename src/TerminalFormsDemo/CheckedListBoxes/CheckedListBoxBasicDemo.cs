@@ -0,0 +1,30 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.CheckedListBoxes;
+
+public class CheckedListBoxBasicDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Checked List Demo" };
+        CheckedListBox checkedListBox = new() { Bounds = new(1, 1, 20, 5) };
+        checkedListBox.Items.AddRange(Enumerable.Range(0, 5000).Select(i => $"Flag {i}").ToArray());
+
+        // Items 0 and 1, as packed bits.
+        checkedListBox.SetCheckedBits(0, 8, [0b11]);
+        Label countLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"Checked: {checkedListBox.CheckedCount} of {checkedListBox.Items.Count}",
+        };
+
+        checkedListBox.CheckedItemsChanged += (sender, e) =>
+        {
+            countLabel.Text = $"Checked: {checkedListBox.CheckedCount} of {checkedListBox.Items.Count}";
+        };
+
+        form.Controls.Add(checkedListBox);
+        form.Controls.Add(countLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,24 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.Labels;
+
+public class WrappedLabelDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+
+        // Four rows high, so the text wraps at the line feed and at spaces.
+        Label label = new()
+        {
+            Bounds = new(1, 1, 18, 4),
+            Text = "Status:\nThe quick brown fox jumps over the lazy dog",
+        };
+
+        // Setting the same text again changes nothing and does not redraw.
+        label.Text = "Status:\nThe quick brown fox jumps over the lazy dog";
+
+        form.Controls.Add(label);
+        form.Show();
+    }
+}
@@ -0,0 +1,32 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxBulkDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Bulk Items Demo" };
+        ListBox listBox = new() { Bounds = new(1, 1, 20, 5) };
+
+        var eventCount = 0;
+        listBox.SelectedIndexChanged += (sender, e) => eventCount++;
+
+        // One event for selecting the first item, one for removing it.
+        listBox.Items.AddRange(Enumerable.Range(0, 50_000).Select(i => $"Item {i}"));
+        listBox.Items.RemoveRange(0, 2);
+
+        Label countLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"Count: {listBox.Items.Count}",
+        };
+
+        Label eventLabel = new() { Bounds = new(1, 7, 30, 1), Text = $"Events: {eventCount}" };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(countLabel);
+        form.Controls.Add(eventLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,37 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxFilterDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Filter Demo" };
+        ListBox listBox = new("server-01", "db-01", "Server-02", "web-01", "SERVER-10")
+        {
+            Bounds = new(1, 1, 20, 5),
+        };
+        listBox.SelectedIndex = 2;
+
+        // The second filter contains the first, so it only rechecks the rows the first one kept.
+        listBox.Filter = "SERVER";
+        listBox.Filter = "server-0";
+
+        Label countLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"Shown: {listBox.DisplayCount} of {listBox.Items.Count}",
+        };
+
+        Label selectionLabel = new()
+        {
+            Bounds = new(1, 7, 30, 1),
+            Text = $"Row {listBox.SelectedDisplayIndex} = item {listBox.SelectedIndex}",
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(countLabel);
+        form.Controls.Add(selectionLabel);
+        form.Show();
+    }
+}
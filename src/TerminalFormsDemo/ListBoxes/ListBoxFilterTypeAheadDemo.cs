@@ -0,0 +1,32 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxFilterTypeAheadDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+        ListBox listBox = new("Carrot", "Apple", "Chive", "Cherry", "Banana")
+        {
+            Bounds = new(1, 1, 20, 5),
+        };
+
+        // "Carrot" is the first item starting with "c", but the filter hides it, so typing "c" finds "Cherry".
+        listBox.Filter = "h";
+
+        Label selectionLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"Selected: {listBox.SelectedItem}",
+        };
+        listBox.SelectedIndexChanged += (sender, e) =>
+        {
+            selectionLabel.Text = $"Selected: {listBox.SelectedItem ?? "(none)"}";
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(selectionLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,30 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxMultiSelectDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Multi-Select Demo" };
+        ListBox listBox = new("Alpha", "Bravo", "Charlie", "Delta", "Echo")
+        {
+            Bounds = new(1, 1, 20, 5),
+            MultiSelect = true,
+        };
+        Label rangesLabel = new() { Bounds = new(1, 6, 30, 1), Text = "Ranges: 0+1" };
+        Label countLabel = new() { Bounds = new(1, 7, 30, 1), Text = "Count: 1" };
+
+        listBox.SelectionChanged += (sender, e) =>
+        {
+            var ranges = listBox.GetSelectedRanges().Select(r => $"{r.Index}+{r.Count}");
+            rangesLabel.Text = $"Ranges: {string.Join(" ", ranges)}";
+            countLabel.Text = $"Count: {listBox.SelectedCount}";
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(rangesLabel);
+        form.Controls.Add(countLabel);
+        form.Show();
+    }
+}
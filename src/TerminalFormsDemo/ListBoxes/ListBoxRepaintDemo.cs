@@ -0,0 +1,30 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxRepaintDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Repaint Demo" };
+        ListBox listBox = new("One", "Two", "Three", "Four", "Five")
+        {
+            Bounds = new(1, 1, 20, 5),
+        };
+        Label cellsLabel = new() { Bounds = new(1, 6, 30, 1), Text = "Moved: -" };
+
+        // SelectedIndexChanged fires before the move is painted, so each event measures the move before it.
+        long? previousCells = null;
+        listBox.SelectedIndexChanged += (sender, e) =>
+        {
+            var cells = listBox.CellsWritten;
+            if (previousCells != null)
+                cellsLabel.Text = $"Moved: {cells - previousCells} cells";
+            previousCells = cells;
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(cellsLabel);
+        form.Show();
+    }
+}
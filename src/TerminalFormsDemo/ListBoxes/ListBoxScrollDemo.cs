@@ -0,0 +1,37 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxScrollDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Scroll Demo" };
+        int fetches = 0;
+        ListBox listBox = new()
+        {
+            Bounds = new(1, 1, 20, 5),
+            VirtualItemProvider = index =>
+            {
+                fetches++;
+                return $"Row {index}";
+            },
+        };
+        listBox.VirtualListSize = 100;
+        Label fetchedLabel = new() { Bounds = new(1, 6, 30, 1), Text = "Fetched: -" };
+
+        // SelectedIndexChanged fires before the move is painted, so each event measures the move before it. The first
+        // Page Down scrolls by one row, so the four rows that stay in view are not fetched again.
+        int? previousFetches = null;
+        listBox.SelectedIndexChanged += (sender, e) =>
+        {
+            if (previousFetches != null)
+                fetchedLabel.Text = $"Fetched: {fetches - previousFetches} of 5";
+            previousFetches = fetches;
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(fetchedLabel);
+        form.Show();
+    }
+}
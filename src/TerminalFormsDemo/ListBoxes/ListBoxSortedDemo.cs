@@ -0,0 +1,30 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxSortedDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Sorted Demo" };
+        ListBox listBox = new("file10", "File2", "file1")
+        {
+            Bounds = new(1, 1, 20, 5),
+            SortOrder = ListBoxSortOrder.Natural,
+        };
+
+        // Each of these lands where it sorts; the selected "file10" moves along with them.
+        listBox.Items.Add("file9");
+        listBox.Items[0] = "file5";
+
+        Label selectionLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"{listBox.SelectedItem} at {listBox.SelectedIndex}",
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(selectionLabel);
+        form.Show();
+    }
+}
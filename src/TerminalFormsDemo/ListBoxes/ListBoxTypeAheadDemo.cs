@@ -0,0 +1,31 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxTypeAheadDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Type-Ahead Demo" };
+        ListBox listBox = new("Date", "Cherry", "apple", "Chive", "banana")
+        {
+            Bounds = new(1, 1, 20, 5),
+        };
+        Label selectionLabel = new() { Bounds = new(1, 6, 30, 1), Text = "Selected: Date" };
+        Label findLabel = new()
+        {
+            Bounds = new(1, 7, 30, 1),
+            Text = $"Find \"A\": {listBox.FindPrefix("A")}",
+        };
+
+        listBox.SelectedIndexChanged += (sender, e) =>
+        {
+            selectionLabel.Text = $"Selected: {listBox.SelectedItem ?? "(none)"}";
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(selectionLabel);
+        form.Controls.Add(findLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,20 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxUnicodeDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Unicode Demo" };
+
+        // Each item's display width is measured once when it is added, not on every draw.
+        ListBox listBox = new("Café", "Crème brûlée", "Ñandú", "Zürich", "Smørrebrød")
+        {
+            Bounds = new(1, 1, 20, 5),
+        };
+
+        form.Controls.Add(listBox);
+        form.Show();
+    }
+}
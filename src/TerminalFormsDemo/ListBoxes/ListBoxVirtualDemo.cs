@@ -0,0 +1,37 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.ListBoxes;
+
+public class ListBoxVirtualDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Virtual List Demo" };
+        ListBox listBox = new()
+        {
+            Bounds = new(1, 1, 20, 5),
+            VirtualItemProvider = index => $"Row {index}",
+        };
+        listBox.VirtualListSize = 1_000_000;
+
+        // Only the rows around the selection are ever requested from the provider.
+        listBox.SelectedIndex = 999_998;
+
+        Label indexLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"Index: {listBox.SelectedIndex}",
+        };
+
+        Label itemLabel = new()
+        {
+            Bounds = new(1, 7, 30, 1),
+            Text = $"Item: {listBox.SelectedItem}",
+        };
+
+        form.Controls.Add(listBox);
+        form.Controls.Add(indexLabel);
+        form.Controls.Add(itemLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,26 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.RadioButtons;
+
+public class RadioButtonGroupManyItemsDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+
+        // More items than Turbo Vision's 32-bit enable mask covers; every one of them can be reached.
+        RadioButtonGroup radioGroup = new() { Bounds = new(1, 1, 15, 5) };
+        radioGroup.Items.Clear();
+        radioGroup.Items.AddRange(Enumerable.Range(0, 40).Select(i => $"Item {i}"));
+
+        Label statusLabel = new() { Bounds = new(1, 6, 30, 1), Text = "Selected: Item 0" };
+        radioGroup.SelectedIndexChanged += (sender, e) =>
+        {
+            statusLabel.Text = $"Selected: {radioGroup.SelectedItem}";
+        };
+
+        form.Controls.Add(radioGroup);
+        form.Controls.Add(statusLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,27 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.RadioButtons;
+
+public class RadioButtonGroupScrollDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new() { Text = "Scroll Demo" };
+        RadioButtonGroup radioGroup = new() { Bounds = new(1, 1, 15, 5) };
+
+        // All 200 items cross to the native side in one call; only the five on screen are drawn.
+        radioGroup.Items.Clear();
+        radioGroup.Items.AddRange(Enumerable.Range(0, 200).Select(i => $"Region {i}"));
+        radioGroup.SelectedIndex = 150;
+
+        Label countLabel = new()
+        {
+            Bounds = new(1, 6, 30, 1),
+            Text = $"Items: {radioGroup.Items.Count}",
+        };
+
+        form.Controls.Add(radioGroup);
+        form.Controls.Add(countLabel);
+        form.Show();
+    }
+}
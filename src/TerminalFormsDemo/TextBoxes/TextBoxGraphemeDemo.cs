@@ -0,0 +1,36 @@
+using System.Text;
+using TerminalForms;
+
+namespace TerminalFormsDemo.TextBoxes;
+
+public class TextBoxGraphemeDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+
+        // "Café" with a combining accent, then a flag made of two regional indicators.
+        TextBox textBox = new() { Text = "Cafe\u0301 \U0001F1EB\U0001F1F7" };
+        textBox.SelectAll();
+        Label lengthLabel = new() { Bounds = new(1, 1, 30, 1), Text = $"Length: {textBox.SelectionLength}" };
+
+        // Selections cover whole characters, however many bytes they take.
+        textBox.Select(3, 1);
+        Label accentLabel = new()
+        {
+            Bounds = new(1, 2, 30, 1),
+            Text = $"Accent: {Encoding.UTF8.GetByteCount(textBox.SelectedText)} bytes",
+        };
+        textBox.Select(5, 1);
+        Label flagLabel = new()
+        {
+            Bounds = new(1, 3, 30, 1),
+            Text = $"Flag: {Encoding.UTF8.GetByteCount(textBox.SelectedText)} bytes",
+        };
+
+        form.Controls.Add(lengthLabel);
+        form.Controls.Add(accentLabel);
+        form.Controls.Add(flagLabel);
+        form.Show();
+    }
+}
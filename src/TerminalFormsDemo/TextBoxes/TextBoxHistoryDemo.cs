@@ -0,0 +1,29 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.TextBoxes;
+
+public class TextBoxHistoryDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+        TextBox textBox = new() { Bounds = new(1, 1, 20, 1) };
+        textBox.History.Capacity = 256;
+        textBox.History.Add("cat");
+        textBox.History.Add("cargo");
+        textBox.History.Add("dog");
+        textBox.History.Add("car");
+
+        var matches = textBox.History.GetSuggestions("ca", 10);
+        Label matchesLabel = new()
+        {
+            Bounds = new(1, 3, 30, 1),
+            Text = $"{matches.Length} match \"ca\"",
+        };
+
+        // The input types "ca" and presses Up twice, recalling "car" and then "cargo".
+        form.Controls.Add(textBox);
+        form.Controls.Add(matchesLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,23 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.TextBoxes;
+
+public class TextBoxMaxLengthDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+        TextBox textBox = new() { Bounds = new(1, 1, 20, 1), MaxLength = 1000 };
+        textBox.Text = "Connection=" + new string('x', 600);
+        Label storedLabel = new() { Bounds = new(1, 3, 30, 1), Text = $"Stored: {textBox.Text.Length}" };
+
+        // Lowering the limit truncates the text in place.
+        textBox.MaxLength = 10;
+        Label cutLabel = new() { Bounds = new(1, 4, 30, 1), Text = $"Cut to: {textBox.Text.Length}" };
+
+        form.Controls.Add(textBox);
+        form.Controls.Add(storedLabel);
+        form.Controls.Add(cutLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,27 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.TextBoxes;
+
+public class TextBoxPasteDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+        TextBox textBox = new() { Bounds = new(1, 1, 20, 1) };
+        Label statusLabel = new() { Bounds = new(1, 3, 30, 1), Text = "Changes: 0" };
+        int changeCount = 0;
+
+        textBox.TextChanged += (sender, e) =>
+        {
+            changeCount++;
+            statusLabel.Text = $"Changes: {changeCount}";
+        };
+
+        // One edit for the whole text; the line break and tab become spaces.
+        textBox.Paste("one\r\ntwo\tthree");
+
+        form.Controls.Add(textBox);
+        form.Controls.Add(statusLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,36 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.TextBoxes;
+
+public class TextBoxSuggestionDemo : IDemo
+{
+    private static readonly string[] Fruits =
+    [
+        "Apple",
+        "Apricot",
+        "Banana",
+        "Blackberry",
+        "Blueberry",
+        "Cherry",
+    ];
+
+    public void Setup()
+    {
+        Form form = new();
+        ListBox listBox = new() { Bounds = new(1, 2, 20, 5) };
+        TextBox textBox = new()
+        {
+            Bounds = new(1, 1, 20, 1),
+            SuggestionList = listBox,
+
+            // Runs on a background thread; the list box is updated on the UI thread.
+            SuggestionProvider = text =>
+                Fruits.Where(fruit => fruit.StartsWith(text, StringComparison.OrdinalIgnoreCase)),
+        };
+
+        // The input types "b".
+        form.Controls.Add(textBox);
+        form.Controls.Add(listBox);
+        form.Show();
+    }
+}
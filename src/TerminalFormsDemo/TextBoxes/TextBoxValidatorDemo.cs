@@ -0,0 +1,28 @@
+using TerminalForms;
+
+namespace TerminalFormsDemo.TextBoxes;
+
+public class TextBoxValidatorDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+        var octet = @"(25[0-5]|2[0-4]\d|1\d\d|[1-9]?\d)";
+        TextBox textBox = new()
+        {
+            Bounds = new(1, 1, 20, 1),
+            Validator = new PatternValidator($@"({octet}\.){{3}}{octet}"),
+        };
+        Label statusLabel = new() { Bounds = new(1, 3, 30, 1), Text = "Empty" };
+
+        // The input types "192.x5"; the "x" cannot lead to an IP address and is refused.
+        textBox.TextChanged += (sender, e) =>
+        {
+            statusLabel.Text = textBox.IsInputValid ? "Complete" : "Incomplete";
+        };
+
+        form.Controls.Add(textBox);
+        form.Controls.Add(statusLabel);
+        form.Show();
+    }
+}
@@ -0,0 +1,29 @@
+using TerminalForms;
+using Timer = TerminalForms.Timer;
+
+namespace TerminalFormsDemo.Timers;
+
+public class TimerTickDemo : IDemo
+{
+    public void Setup()
+    {
+        Form form = new();
+
+        Label label = new() { Bounds = new(1, 1, 18, 1), Text = "Ticks: 0" };
+        form.Controls.Add(label);
+
+        // Stops itself on the second tick.
+        var count = 0;
+        Timer timer = new() { Interval = 10 };
+        timer.Tick += (sender, e) =>
+        {
+            count++;
+            label.Text = $"Ticks: {count}";
+            if (count == 2)
+                timer.Stop();
+        };
+        timer.Start();
+
+        form.Show();
+    }
+}
@@ -38,6 +38,63 @@ public class DemoTest
         Test(name);
     }
 
+    [TestMethod]
+    public void TestListBoxScrollOutputBytes()
+    {
+        if (!RuntimeInformation.IsOSPlatform(OSPlatform.Linux))
+            Assert.Inconclusive("Output is only measured through a PTY on Linux.");
+
+        // The same demo with and without one Page Down, which scrolls the list box by one row. The
+        // difference is what the scroll sent to the terminal. Turbo Vision sends only the cells
+        // that differ from the last frame, so a row that moved costs only the characters where it
+        // differs from the row that was there before.
+        var idle = MeasureOutputBytes("ListBoxes.ListBoxScrollDemo", "");
+        var scrolled = MeasureOutputBytes(
+            "ListBoxes.ListBoxScrollDemo",
+            "KEYDOWN code: 20736 ctrl: 0 text:\n"
+        );
+        var scroll = scrolled - idle;
+        Assert.IsTrue(
+            scroll > 0 && scroll < idle / 4,
+            $"One-row scroll wrote {scroll} bytes; drawing the whole screen wrote {idle}."
+        );
+    }
+
+    private static long MeasureOutputBytes(string name, string events)
+    {
+        var actualFilePath = Path.Combine(Path.GetTempPath(), "TerminalFormsDemo.txt");
+        var logFilePath = Path.Combine(Path.GetTempPath(), "TerminalFormsDemo.log");
+        var eventsFilePath = Path.Combine(Path.GetTempPath(), "TerminalFormsDemo-input.txt");
+        File.WriteAllText(eventsFilePath, $"# Generated by {nameof(MeasureOutputBytes)}\n{events}");
+
+        try
+        {
+            var demoDll = Path.Combine(
+                Path.GetDirectoryName(typeof(IDemo).Assembly.Location)!,
+                "TerminalFormsDemo.dll"
+            );
+            var demoArgs =
+                $"\"{demoDll}\" --test \"{name}\" --output \"{actualFilePath}\""
+                + $" --log \"{logFilePath}\" --input \"{eventsFilePath}\"";
+            var exitCode = PtyProcess.Run(
+                "dotnet",
+                demoArgs,
+                rows: 12,
+                cols: 40,
+                timeoutMs: 10000,
+                out var outputBytes
+            );
+            Assert.AreEqual(0, exitCode, $"Exit code {exitCode} running {name}.");
+            return outputBytes;
+        }
+        finally
+        {
+            File.Delete(actualFilePath);
+            File.Delete(logFilePath);
+            File.Delete(eventsFilePath);
+        }
+    }
+
     private static void Test(string name)
     {
         var actualFilePath = Path.Combine(Path.GetTempPath(), "TerminalFormsDemo.txt");
@@ -56,7 +56,28 @@ internal static class PtyProcess
     /// <param name="cols">Terminal columns (width).</param>
     /// <param name="timeoutMs">Timeout in milliseconds.</param>
     /// <returns>The process exit code.</returns>
-    public static int Run(string fileName, string arguments, int rows, int cols, int timeoutMs)
+    public static int Run(string fileName, string arguments, int rows, int cols, int timeoutMs) =>
+        Run(fileName, arguments, rows, cols, timeoutMs, out _);
+
+    /// <summary>
+    /// Runs a process in a PTY with the specified terminal size, and counts the bytes it writes to
+    /// the terminal.
+    /// </summary>
+    /// <param name="fileName">The executable to run.</param>
+    /// <param name="arguments">Command line arguments.</param>
+    /// <param name="rows">Terminal rows (height).</param>
+    /// <param name="cols">Terminal columns (width).</param>
+    /// <param name="timeoutMs">Timeout in milliseconds.</param>
+    /// <param name="outputBytes">The number of bytes the process wrote to the terminal.</param>
+    /// <returns>The process exit code.</returns>
+    public static int Run(
+        string fileName,
+        string arguments,
+        int rows,
+        int cols,
+        int timeoutMs,
+        out long outputBytes
+    )
     {
         // Create master side of PTY
         int masterFd = posix_openpt(O_RDWR | O_NOCTTY);
@@ -144,6 +165,7 @@ internal static class PtyProcess
 
             // Drain the master fd to prevent the child from blocking on writes
             var cts = new CancellationTokenSource();
+            long totalBytes = 0;
             var drainTask = Task.Run(() =>
             {
                 var buffer = new byte[4096];
@@ -154,6 +176,7 @@ internal static class PtyProcess
                         nint bytesRead = read(masterFd, buffer, buffer.Length);
                         if (bytesRead <= 0)
                             break;
+                        Interlocked.Add(ref totalBytes, bytesRead);
                     }
                 }
                 catch
@@ -169,7 +192,11 @@ internal static class PtyProcess
                 throw new TimeoutException($"Process timed out after {timeoutMs}ms");
             }
 
+            // The read fails once the child has exited and closed the slave side, after the last of
+            // its output.
+            drainTask.Wait(1000);
             cts.Cancel();
+            outputBytes = Interlocked.Read(ref totalBytes);
             return process.ExitCode;
         }
         finally
@@ -1,4 +1,5 @@
 #include "Application.h"
+#include "SuggestionPipeline.h"
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -16,12 +17,20 @@ namespace tf {
 
 Application Application::instance;
 
-Application::Application() : TProgInit(TProgram::initStatusLine, TProgram::initMenuBar, TProgram::initDeskTop) {}
+Application::Application()
+    : TProgInit(TProgram::initStatusLine, TProgram::initMenuBar, TProgram::initDeskTop),
+      pollTimeoutMs_(eventTimeoutMs) {}
 
 Application::~Application() {}
 
 void Application::idle() {
     TApplication::idle();
+    SuggestionPipeline::deliverReady();
+    fdWatcher_.dispatch();
+    postQueue_.drain();
+    timerWheel_.fire(TimerWheel::now());
+    frameScheduler_.render(this, TimerWheel::now(), false);
+    updateEventTimeout();
 
     if (debugScreenshotEnabled_) {
         saveDebugScreenshot();
@@ -42,6 +51,64 @@ void Application::idle() {
     }
 }
 
+void Application::getEvent(TEvent& event) {
+    // Also reached from the mouse-tracking loops inside event handlers, which don't return to the event loop until the
+    // button is released, so deferred drawing keeps up with them.
+    frameScheduler_.render(this, TimerWheel::now(), false);
+    TApplication::getEvent(event);
+
+    if (event.what == evMouseDown) {
+        mouseHeld_ = true;
+    } else if (event.what == evMouseUp) {
+        mouseHeld_ = false;
+    }
+
+    // The handler for this event may start a timer, so don't sleep on the old timeout; the next wait returns at once,
+    // and idle() works out a new one.
+    if (event.what != evNothing) {
+        eventTimeoutMs = 0;
+    }
+}
+
+void Application::invalidate(TView* view) {
+    if (!instance.frameScheduler_.defer(view)) {
+        view->drawView();
+    }
+}
+
+bool Application::deferDraw(TView* view) {
+    return instance.frameScheduler_.defer(view);
+}
+
+void Application::flushFrame() {
+    frameScheduler_.render(this, TimerWheel::now(), true);
+    TScreen::flushScreen();
+}
+
+void Application::setDeferredDrawing(bool value) {
+    frameScheduler_.setDeferred(value);
+    if (!value) {
+        flushFrame();
+    }
+}
+
+// Sleeps until the next timer or frame is due, or until input or a wake-up arrives if neither is, instead of waking on
+// a fixed poll. The poll is kept while a mouse button is held, since Turbo Vision makes its auto-repeat mouse events
+// on waking, and in the debug modes, which count passes through idle().
+void Application::updateEventTimeout() {
+    uint64_t now = TimerWheel::now();
+    int32_t timeout = timerWheel_.getTimeout(now);
+    int32_t frameTimeout = frameScheduler_.getTimeout(now);
+    if (frameTimeout >= 0 && (timeout < 0 || frameTimeout < timeout)) {
+        timeout = frameTimeout;
+    }
+    bool poll = mouseHeld_ || debugScreenshotEnabled_ || debugEventsEnabled_;
+    if (poll && (timeout < 0 || timeout > pollTimeoutMs_)) {
+        timeout = pollTimeoutMs_;
+    }
+    eventTimeoutMs = timeout;
+}
+
 // Implements fixed-size debug screenshots by capturing only the top-left 40×12 region of the actual screen buffer.
 // This approach avoids the complexity of overriding TurboVision's screen dimensions (which get reset by various
 // internal operations) and simply crops the output during the screenshot saving process. The critical insight was
@@ -282,3 +349,127 @@ TF_EXPORT tf::Error TfApplicationStaticEnableDebugEvents(const char* inputFile)
 
     return tf::Success;
 }
+
+TF_EXPORT tf::Error TfApplicationStaticWatchFd(int32_t fd,
+                                               int32_t events,
+                                               tf::FdWatchFunction function,
+                                               void* userData) {
+    if (!function) {
+        return tf::Error_ArgumentNull;
+    }
+    if (fd < 0 || events & ~(tf::WatchEvents_Read | tf::WatchEvents_Write) ||
+        !(events & (tf::WatchEvents_Read | tf::WatchEvents_Write))) {
+        return tf::Error_InvalidArgument;
+    }
+
+    try {
+        std::string error;
+        if (!tf::Application::instance.getFdWatcher().watch(fd, events, function, userData, &error)) {
+            tf::setLastErrorMessage(error);
+            return static_cast<tf::Error>(tf::Error_InvalidArgument | tf::Error_HasMessage);
+        }
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    } catch (const std::exception& e) {
+        tf::setLastErrorMessage(e.what());
+        return static_cast<tf::Error>(tf::Error_Unknown | tf::Error_HasMessage);
+    }
+
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticUnwatchFd(int32_t fd) {
+    tf::Application::instance.getFdWatcher().unwatch(fd);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticPost(tf::EventHandlerFunction function, void* userData) {
+    if (!function) {
+        return tf::Error_ArgumentNull;
+    }
+
+    try {
+        tf::Application::instance.getPostQueue().post(function, userData);
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    }
+
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticGetTimerSlack(int32_t* out) {
+    if (!out) {
+        return tf::Error_ArgumentNull;
+    }
+
+    *out = tf::Application::instance.getTimerWheel().getSlack();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticSetTimerSlack(int32_t value) {
+    if (value < 1) {
+        return tf::Error_InvalidArgument;
+    }
+
+    tf::Application::instance.getTimerWheel().setSlack(value);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticGetDeferredDrawing(BOOL* out) {
+    if (!out) {
+        return tf::Error_ArgumentNull;
+    }
+
+    *out = tf::Application::instance.getFrameScheduler().getDeferred() ? TRUE : FALSE;
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticSetDeferredDrawing(BOOL value) {
+    try {
+        tf::Application::instance.setDeferredDrawing(value != FALSE);
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    }
+
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticGetMaxFrameRate(int32_t* out) {
+    if (!out) {
+        return tf::Error_ArgumentNull;
+    }
+
+    *out = tf::Application::instance.getFrameScheduler().getMaxFrameRate();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticSetMaxFrameRate(int32_t value) {
+    if (value < 0 || value > 1000) {
+        return tf::Error_InvalidArgument;
+    }
+
+    tf::Application::instance.getFrameScheduler().setMaxFrameRate(value);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticFlushFrame() {
+    try {
+        tf::Application::instance.flushFrame();
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    }
+
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfApplicationStaticGetFrameCounters(int64_t* frames, int64_t* invalidations, int64_t* draws) {
+    if (!frames || !invalidations || !draws) {
+        return tf::Error_ArgumentNull;
+    }
+
+    auto& scheduler = tf::Application::instance.getFrameScheduler();
+    *frames = scheduler.getFrameCount();
+    *invalidations = scheduler.getInvalidationCount();
+    *draws = scheduler.getDrawCount();
+    return tf::Success;
+}
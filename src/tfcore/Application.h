@@ -1,6 +1,10 @@
 #pragma once
 
 #include "common.h"
+#include "FdWatcher.h"
+#include "FrameScheduler.h"
+#include "PostQueue.h"
+#include "TimerWheel.h"
 #include <queue>
 
 #define Uses_TApplication
@@ -17,9 +21,24 @@ class Application : public TApplication {
     virtual ~Application();
 
     void idle() override;
+    void getEvent(TEvent& event) override;
     void enableDebugScreenshot(const std::string& outputFile);
     void enableDebugEvents(const std::string& inputFile);
 
+    // Redraws `view` now, or on the next frame when drawing is deferred. Setters call this instead of drawView().
+    static void invalidate(TView* view);
+    // For views that repaint only what changed: returns true if the redraw was deferred, in which case the whole view
+    // is drawn on the next frame, or false if the caller should repaint now.
+    static bool deferDraw(TView* view);
+
+    // Draws the views waiting for the next frame and flushes the screen, without waiting for the frame to be due.
+    void flushFrame();
+    void setDeferredDrawing(bool value);
+    FdWatcher& getFdWatcher() { return fdWatcher_; }
+    PostQueue& getPostQueue() { return postQueue_; }
+    TimerWheel& getTimerWheel() { return timerWheel_; }
+    FrameScheduler& getFrameScheduler() { return frameScheduler_; }
+
    private:
     bool debugScreenshotEnabled_ = false;
     std::string debugScreenshotOutputFile_;
@@ -27,6 +46,17 @@ class Application : public TApplication {
     bool debugEventsEnabled_ = false;
     std::queue<TEvent> debugEventsQueue_;
 
+    FdWatcher fdWatcher_;
+    PostQueue postQueue_;
+    TimerWheel timerWheel_;
+    FrameScheduler frameScheduler_;
+
+    // Turbo Vision's fixed event wait, still used while polling is needed.
+    int pollTimeoutMs_;
+    bool mouseHeld_ = false;
+
+    void updateEventTimeout();
+
     void saveDebugScreenshot();
 };
 
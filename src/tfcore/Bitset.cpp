@@ -0,0 +1,145 @@
+#include "Bitset.h"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace tf {
+
+static inline int32_t countBits(uint64_t value) {
+#ifdef _MSC_VER
+    return static_cast<int32_t>(__popcnt64(value));
+#else
+    return __builtin_popcountll(value);
+#endif
+}
+
+static inline uint64_t lowMask(int32_t count) {
+    return count >= 64 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << count) - 1;
+}
+
+uint64_t Bitset::readBits(int64_t position, int32_t count) const {
+    // Reads `count` (at most 64) bits starting at any bit position; they may straddle two words.
+    int64_t word = position >> 6;
+    int32_t shift = static_cast<int32_t>(position & 63);
+    uint64_t value = words[word] >> shift;
+    if (shift != 0 && shift + count > 64) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return value & lowMask(count);
+}
+
+void Bitset::writeBits(int64_t position, int32_t count, uint64_t value) {
+    int64_t word = position >> 6;
+    int32_t shift = static_cast<int32_t>(position & 63);
+    uint64_t mask = lowMask(count);
+    value &= mask;
+    words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+    if (shift != 0 && shift + count > 64) {
+        words[word + 1] = (words[word + 1] & ~(mask >> (64 - shift))) | (value >> (64 - shift));
+    }
+}
+
+void Bitset::moveBits(int64_t from, int64_t to, int64_t count) {
+    // Like memmove(): copies 64 bits at a time, front to back when moving down and back to front when moving up, so
+    // overlapping ranges are safe.
+    if (from > to) {
+        for (int64_t i = 0; i < count; i += 64) {
+            int32_t n = static_cast<int32_t>(std::min<int64_t>(64, count - i));
+            writeBits(to + i, n, readBits(from + i, n));
+        }
+    } else if (from < to) {
+        for (int64_t end = count; end > 0; end -= 64) {
+            int32_t n = static_cast<int32_t>(std::min<int64_t>(64, end));
+            writeBits(to + end - n, n, readBits(from + end - n, n));
+        }
+    }
+}
+
+int32_t Bitset::setRange(int32_t index, int32_t count, bool value) {
+    int32_t changed = 0;
+    for (int32_t i = 0; i < count; i += 64) {
+        int32_t n = std::min(64, count - i);
+        uint64_t bits = value ? lowMask(n) : 0;
+        changed += countBits(readBits(index + i, n) ^ bits);
+        writeBits(index + i, n, bits);
+    }
+    setCount += value ? changed : -changed;
+    return changed;
+}
+
+void Bitset::copyBits(int32_t first, int32_t count, uint8_t* bits) const {
+    for (int32_t i = 0; i < count; i += 8) {
+        bits[i / 8] = static_cast<uint8_t>(readBits(first + i, std::min(8, count - i)));
+    }
+}
+
+int32_t Bitset::setBits(int32_t first, int32_t count, const uint8_t* bits) {
+    int32_t changed = 0;
+    for (int32_t i = 0; i < count; i += 8) {
+        int32_t n = std::min(8, count - i);
+        uint64_t oldBits = readBits(first + i, n);
+        uint64_t newBits = bits[i / 8] & lowMask(n);
+        changed += countBits(oldBits ^ newBits);
+        setCount += countBits(newBits) - countBits(oldBits);
+        writeBits(first + i, n, newBits);
+    }
+    return changed;
+}
+
+void Bitset::resize(int32_t newSize) {
+    if (newSize < size) {
+        setRange(newSize, size - newSize, false);
+    }
+    words.resize((static_cast<size_t>(newSize) + 63) / 64);
+    size = newSize;
+}
+
+void Bitset::insert(int32_t index, int32_t count) {
+    if (count <= 0) {
+        return;
+    }
+    int32_t oldSize = size;
+    resize(size + count);
+    moveBits(index, static_cast<int64_t>(index) + count, oldSize - index);
+    for (int32_t i = 0; i < count; i += 64) {
+        writeBits(static_cast<int64_t>(index) + i, std::min(64, count - i), 0);
+    }
+}
+
+void Bitset::removeRange(int32_t index, int32_t count) {
+    if (count <= 0) {
+        return;
+    }
+    // Clearing first keeps the count right and leaves zeros to fall off the end.
+    setRange(index, count, false);
+    moveBits(static_cast<int64_t>(index) + count, index, size - index - count);
+    for (int32_t i = size - count; i < size; i += 64) {
+        writeBits(i, std::min(64, size - i), 0);
+    }
+    resize(size - count);
+}
+
+void Bitset::reorder(const std::vector<int32_t>& order) {
+    std::vector<uint64_t> reordered(words.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        if (get(order[i])) {
+            reordered[i >> 6] |= uint64_t{ 1 } << (i & 63);
+        }
+    }
+    words.swap(reordered);
+}
+
+void Bitset::clear() {
+    words.clear();
+    size = 0;
+    setCount = 0;
+}
+
+int64_t Bitset::getMemoryUsage() const {
+    return static_cast<int64_t>(words.capacity() * sizeof(uint64_t));
+}
+
+}  // namespace tf
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common.h"
+
+#include <vector>
+
+namespace tf {
+
+// A growable array of bits, one per item, packed 64 to a word. The number of set bits is kept up to date as bits
+// change, so getSetCount() never scans. Bits past getSize() in the last word are always zero.
+//
+// Like RangeSet, the bitset does not observe the items; the owner calls insert(), remove() and reorder() as they
+// change.
+class Bitset {
+   public:
+    int32_t getSize() const { return size; }
+    int32_t getSetCount() const { return setCount; }
+    bool get(int32_t index) const { return (words[index >> 6] >> (index & 63)) & 1; }
+
+    // Sets bits [index, index + count) to `value`. Returns the number of bits that changed.
+    int32_t setRange(int32_t index, int32_t count, bool value);
+
+    // Packed copies of bits [first, first + count): bit i of the range is bit (i % 8) of byte i / 8, least significant
+    // first. setBits() returns the number of bits that changed.
+    void copyBits(int32_t first, int32_t count, uint8_t* bits) const;
+    int32_t setBits(int32_t first, int32_t count, const uint8_t* bits);
+
+    // Grows with clear bits or shrinks from the end.
+    void resize(int32_t newSize);
+
+    // Inserts `count` clear bits before `index`, moving the later bits up.
+    void insert(int32_t index, int32_t count);
+
+    // Removes bits [index, index + count), moving the later bits down.
+    void removeRange(int32_t index, int32_t count);
+
+    // Rearranges the bits so that bit i is the old bit order[i], as StringArena::reorder() does for items.
+    void reorder(const std::vector<int32_t>& order);
+
+    void clear();
+
+    int64_t getMemoryUsage() const;
+
+   private:
+    uint64_t readBits(int64_t position, int32_t count) const;
+    void writeBits(int64_t position, int32_t count, uint64_t value);
+    void moveBits(int64_t from, int64_t to, int64_t count);
+
+    std::vector<uint64_t> words;
+    int32_t size{ 0 };
+    int32_t setCount{ 0 };
+};
+
+}  // namespace tf
@@ -1,4 +1,5 @@
 #include "Button.h"
+#include "Application.h"
 
 #define Uses_TRect
 #define Uses_TButton
@@ -25,7 +26,7 @@ BOOL Button::getIsDefault() const {
 void Button::setIsDefault(BOOL value) {
     flags &= ~bfDefault;
     makeDefault(value);
-    drawView();
+    Application::invalidate(this);
 }
 
 int32_t Button::getTextAlign() const {
@@ -38,7 +39,7 @@ void Button::setTextAlign(int32_t value) {
     } else {
         flags &= ~bfLeftJust;
     }
-    drawView();
+    Application::invalidate(this);
 }
 
 BOOL Button::getGrabsFocus() const {
@@ -66,7 +67,7 @@ TF_EXPORT tf::Error TfButtonSetText(tf::Button* self, const char* text) {
 
     delete[] self->title;
     self->title = newStr(text);
-    self->drawView();
+    tf::Application::invalidate(self);
     return tf::Success;
 }
 
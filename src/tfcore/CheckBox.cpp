@@ -1,4 +1,5 @@
 #include "CheckBox.h"
+#include "Application.h"
 
 #define Uses_TRect
 #define Uses_TCheckBoxes
@@ -31,7 +32,7 @@ void CheckBox::setChecked(BOOL value) {
     } else {
         this->value &= ~1;
     }
-    drawView();
+    Application::invalidate(this);
     if (oldValue != getChecked()) {
         stateChangedEventHandler();
     }
@@ -54,7 +55,7 @@ void CheckBox::setText(const char* text) {
             // Insert new string
             strings->atInsert(0, newStr(text));
         }
-        drawView();
+        Application::invalidate(this);
     }
 }
 
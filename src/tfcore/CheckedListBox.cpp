@@ -0,0 +1,124 @@
+#include "CheckedListBox.h"
+
+namespace tf {
+
+CheckedListBox::CheckedListBox() {
+    checkBoxes = true;
+}
+
+void CheckedListBox::setCheckedItemsChangedEventHandler(EventHandlerFunction function, void* userData) {
+    checkedItemsChangedEventHandler = EventHandler(function, userData);
+}
+
+bool CheckedListBox::isItemChecked(int32_t index) const {
+    return checkedItems.get(index);
+}
+
+void CheckedListBox::setItemsChecked(int32_t index, int32_t count, bool checked) {
+    int32_t changed = checkedItems.setRange(index, count, checked);
+    if (changed > 0) {
+        invalidateItems(index, count);
+    }
+    fireCheckedItemsChangedIfNeeded(changed > 0);
+}
+
+int32_t CheckedListBox::getCheckedCount() const {
+    return checkedItems.getSetCount();
+}
+
+void CheckedListBox::getCheckedBits(int32_t index, int32_t count, uint8_t* bits) const {
+    checkedItems.copyBits(index, count, bits);
+}
+
+void CheckedListBox::setCheckedBits(int32_t index, int32_t count, const uint8_t* bits) {
+    int32_t changed = checkedItems.setBits(index, count, bits);
+    if (changed > 0) {
+        invalidateItems(index, count);
+    }
+    fireCheckedItemsChangedIfNeeded(changed > 0);
+}
+
+void CheckedListBox::checkedItemsChanged() {
+    checkedItemsChangedEventHandler();
+}
+
+}  // namespace tf
+
+TF_DEFAULT_CONSTRUCTOR(CheckedListBox)
+
+TF_BOILERPLATE_FUNCTIONS(CheckedListBox)
+
+TF_EXPORT tf::Error TfCheckedListBoxSetCheckedItemsChangedEventHandler(
+    tf::CheckedListBox* self,
+    tf::EventHandlerFunction function,
+    void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setCheckedItemsChangedEventHandler(function, userData);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfCheckedListBoxGetItemChecked(tf::CheckedListBox* self, int32_t index, BOOL* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || index >= self->getItemCount()) {
+        return tf::Error_InvalidArgument;
+    }
+    *out = self->isItemChecked(index) ? TRUE : FALSE;
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfCheckedListBoxSetItemsChecked(
+    tf::CheckedListBox* self,
+    int32_t index,
+    int32_t count,
+    BOOL checked) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || count < 0 || index > self->getItemCount() - count) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setItemsChecked(index, count, checked != FALSE);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfCheckedListBoxGetCheckedCount(tf::CheckedListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getCheckedCount();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfCheckedListBoxGetCheckedBits(
+    tf::CheckedListBox* self,
+    int32_t index,
+    int32_t count,
+    uint8_t* bits) {
+    if (self == nullptr || (bits == nullptr && count > 0)) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || count < 0 || index > self->getItemCount() - count) {
+        return tf::Error_InvalidArgument;
+    }
+    self->getCheckedBits(index, count, bits);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfCheckedListBoxSetCheckedBits(
+    tf::CheckedListBox* self,
+    int32_t index,
+    int32_t count,
+    const uint8_t* bits) {
+    if (self == nullptr || (bits == nullptr && count > 0)) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || count < 0 || index > self->getItemCount() - count) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setCheckedBits(index, count, bits);
+    return tf::Success;
+}
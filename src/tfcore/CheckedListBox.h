@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common.h"
+#include "EventHandler.h"
+#include "ListBox.h"
+
+namespace tf {
+
+// A ListBox with a check box on every row. Check state is one bit per item in a Bitset, so thousands of items cost
+// a few hundred bytes and the checked count is kept as bits change rather than counted. Checked items follow their
+// items through inserts, removals and sorting, as the selection does.
+class CheckedListBox : public ListBox {
+   public:
+    CheckedListBox();
+
+    void setCheckedItemsChangedEventHandler(EventHandlerFunction function, void* userData);
+
+    bool isItemChecked(int32_t index) const;
+    void setItemsChecked(int32_t index, int32_t count, bool checked);
+    int32_t getCheckedCount() const;
+
+    // Packed check state of items [index, index + count): item index + i is bit (i % 8) of byte i / 8, least
+    // significant bit first. `bits` holds (count + 7) / 8 bytes; unused high bits of the last byte are written as zero
+    // and ignored when read.
+    void getCheckedBits(int32_t index, int32_t count, uint8_t* bits) const;
+    void setCheckedBits(int32_t index, int32_t count, const uint8_t* bits);
+
+   protected:
+    virtual void checkedItemsChanged() override;
+
+   private:
+    EventHandler checkedItemsChangedEventHandler{};
+};
+
+template <>
+struct equals<CheckedListBox> {
+    bool operator()(const CheckedListBox& self, const CheckedListBox& other) const { return &self == &other; }
+};
+
+}  // namespace tf
+
+namespace std {
+template <>
+struct hash<tf::CheckedListBox> {
+    std::size_t operator()(const tf::CheckedListBox& p) const noexcept {
+        std::size_t x{};
+        tf::combineHash(&p, &x);
+        return x;
+    }
+};
+}  // namespace std
@@ -0,0 +1,246 @@
+#include "FdWatcher.h"
+
+#define Uses_TEventQueue
+#include <tvision/tv.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace tf {
+
+#ifdef __linux__
+
+// The epoll data of the stop descriptor. Watched descriptors carry their serial, which is never 0, in the high half.
+static const uint64_t stopKey = 0;
+
+static uint64_t keyOf(int32_t fd, uint32_t serial) {
+    return (static_cast<uint64_t>(serial) << 32) | static_cast<uint32_t>(fd);
+}
+
+static uint32_t epollEventsOf(int32_t events) {
+    uint32_t result = EPOLLONESHOT;
+    if (events & WatchEvents_Read) {
+        result |= EPOLLIN;
+    }
+    if (events & WatchEvents_Write) {
+        result |= EPOLLOUT;
+    }
+    return result;
+}
+
+static int32_t watchEventsOf(uint32_t events) {
+    int32_t result = 0;
+    if (events & EPOLLIN) {
+        result |= WatchEvents_Read;
+    }
+    if (events & EPOLLOUT) {
+        result |= WatchEvents_Write;
+    }
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        result |= WatchEvents_Error;
+    }
+    return result;
+}
+
+static std::string describeError(const char* action, int32_t fd, int error) {
+    return std::string(action) + " file descriptor " + std::to_string(fd) + ": " + strerror(error);
+}
+
+FdWatcher::FdWatcher() {}
+
+FdWatcher::~FdWatcher() {
+    if (worker.joinable()) {
+        uint64_t one = 1;
+        while (write(stopFd, &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+        worker.join();
+    }
+    if (stopFd >= 0) {
+        close(stopFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+bool FdWatcher::start(std::string* error) {
+    if (worker.joinable()) {
+        return true;
+    }
+
+    if (epollFd < 0) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0) {
+            *error = std::string("Cannot create the epoll instance: ") + strerror(errno);
+            return false;
+        }
+    }
+
+    if (stopFd < 0) {
+        stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (stopFd < 0) {
+            *error = std::string("Cannot create the stop event: ") + strerror(errno);
+            return false;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = stopKey;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) < 0) {
+            *error = std::string("Cannot watch the stop event: ") + strerror(errno);
+            close(stopFd);
+            stopFd = -1;
+            return false;
+        }
+    }
+
+    worker = std::thread(&FdWatcher::run, this);
+    return true;
+}
+
+bool FdWatcher::arm(int32_t fd, const Watch& watch, bool add, std::string* error) {
+    epoll_event event{};
+    event.events = epollEventsOf(watch.events);
+    event.data.u64 = keyOf(fd, watch.serial);
+
+    if (epoll_ctl(epollFd, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) == 0) {
+        return true;
+    }
+
+    // A descriptor that was closed and reopened under the same number without being unwatched has left the epoll set.
+    if (!add && errno == ENOENT && epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0) {
+        return true;
+    }
+
+    if (error) {
+        *error = describeError("Cannot watch", fd, errno);
+    }
+    return false;
+}
+
+bool FdWatcher::watch(int32_t fd, int32_t events, FdWatchFunction function, void* userData, std::string* error) {
+    if (!start(error)) {
+        return false;
+    }
+
+    if (++nextSerial == 0) {
+        ++nextSerial;
+    }
+    Watch watch{ events, function, userData, nextSerial };
+
+    auto it = watches.find(fd);
+    if (!arm(fd, watch, it == watches.end(), error)) {
+        return false;
+    }
+
+    if (it == watches.end()) {
+        watches.emplace(fd, watch);
+    } else {
+        it->second = watch;
+    }
+    return true;
+}
+
+void FdWatcher::unwatch(int32_t fd) {
+    auto it = watches.find(fd);
+    if (it == watches.end()) {
+        return;
+    }
+    watches.erase(it);
+
+    // Fails harmlessly if the descriptor was already closed, which removes it from the epoll set by itself.
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void FdWatcher::dispatch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ready.empty()) {
+            return;
+        }
+        dispatching.swap(ready);
+    }
+
+    for (auto& item : dispatching) {
+        auto it = watches.find(item.fd);
+        if (it == watches.end() || it->second.serial != item.serial) {
+            continue;
+        }
+
+        auto watch = it->second;
+        watch.function(watch.userData, item.fd, item.events);
+
+        // Re-arm unless the callback unwatched the descriptor or watched it again, which arms it anew.
+        it = watches.find(item.fd);
+        if (it != watches.end() && it->second.serial == item.serial && !arm(item.fd, it->second, false, nullptr)) {
+            watches.erase(it);
+        }
+    }
+    dispatching.clear();
+}
+
+void FdWatcher::run() {
+    epoll_event events[64];
+    for (;;) {
+        int count = epoll_wait(epollFd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            bool wasEmpty = ready.empty();
+            for (int i = 0; i < count; i++) {
+                uint64_t key = events[i].data.u64;
+                if (key == stopKey) {
+                    return;
+                }
+                ready.push_back(Ready{ static_cast<int32_t>(key & 0xFFFFFFFF), static_cast<uint32_t>(key >> 32),
+                                       watchEventsOf(events[i].events) });
+            }
+            wake = wasEmpty && !ready.empty();
+        }
+
+        // One wake-up per batch: until dispatch() empties the list, the UI thread is already due to look at it.
+        if (wake) {
+            TEventQueue::wakeUp();
+        }
+    }
+}
+
+#else
+
+FdWatcher::FdWatcher() {}
+
+FdWatcher::~FdWatcher() {}
+
+bool FdWatcher::start(std::string* error) {
+    *error = "File descriptor watches are only supported on Linux.";
+    return false;
+}
+
+bool FdWatcher::arm(int32_t, const Watch&, bool, std::string*) {
+    return false;
+}
+
+bool FdWatcher::watch(int32_t, int32_t, FdWatchFunction, void*, std::string* error) {
+    return start(error);
+}
+
+void FdWatcher::unwatch(int32_t) {}
+
+void FdWatcher::dispatch() {}
+
+void FdWatcher::run() {}
+
+#endif
+
+}  // namespace tf
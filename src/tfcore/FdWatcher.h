@@ -0,0 +1,87 @@
+#pragma once
+
+#include "common.h"
+
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace tf {
+
+enum WatchEvents {
+    WatchEvents_Read = 1,
+    WatchEvents_Write = 2,
+    WatchEvents_Error = 4,
+};
+
+// Called on the UI thread when `fd` is ready. `events` is a combination of WatchEvents: the interests that are ready,
+// plus WatchEvents_Error if the descriptor has an error or was hung up, which is reported whatever the interest.
+typedef void(TF_CDECL* FdWatchFunction)(void* userData, int32_t fd, int32_t events);
+
+// Watches file descriptors for the Application and runs their callbacks on the UI thread. Linux only.
+//
+// Turbo Vision's event wait can't be given extra descriptors, so a worker thread blocks in epoll_wait() on the watched
+// descriptors instead, and wakes the event queue when any are ready. The Application then calls dispatch() in the same
+// pass of its event loop. Nothing polls: while no descriptor is ready, the worker sleeps in the kernel.
+//
+// Descriptors are registered with EPOLLONESHOT, so a ready descriptor is reported once and then left alone until its
+// callback has run, rather than waking the worker again and again until the UI thread catches up. dispatch() re-arms
+// each descriptor after its callback, and because the watch is level-triggered, data the callback left unread is
+// reported again on the next pass.
+class FdWatcher {
+   public:
+    FdWatcher();
+    ~FdWatcher();
+
+    FdWatcher(const FdWatcher&) = delete;
+    FdWatcher& operator=(const FdWatcher&) = delete;
+
+    // UI thread only. Starts watching `fd` for `events`, or replaces the interest and callback if it is already
+    // watched. Returns false and describes the problem in `error` if the descriptor can't be watched.
+    bool watch(int32_t fd, int32_t events, FdWatchFunction function, void* userData, std::string* error);
+
+    // UI thread only. Stops watching `fd`. Does nothing if it isn't watched. A callback that is due but hasn't run yet
+    // is dropped.
+    void unwatch(int32_t fd);
+
+    // UI thread only. Runs the callbacks of the descriptors that are ready. Callbacks may watch and unwatch
+    // descriptors, including their own.
+    void dispatch();
+
+   private:
+    struct Watch {
+        int32_t events;
+        FdWatchFunction function;
+        void* userData;
+        uint32_t serial;
+    };
+
+    struct Ready {
+        int32_t fd;
+        uint32_t serial;
+        int32_t events;
+    };
+
+    bool start(std::string* error);
+    bool arm(int32_t fd, const Watch& watch, bool add, std::string* error);
+    void run();
+
+    // UI thread only. The serial tells a watch from an earlier one on the same descriptor number, so that a report for
+    // a descriptor that was unwatched, closed and reused isn't delivered to the new watch.
+    std::unordered_map<int32_t, Watch> watches;
+    uint32_t nextSerial{ 0 };
+
+    int epollFd{ -1 };
+    int stopFd{ -1 };
+    std::thread worker;
+
+    // Guarded by `mutex`: descriptors the worker found ready, waiting for dispatch().
+    std::mutex mutex;
+    std::vector<Ready> ready;
+
+    // UI thread only. The batch dispatch() is working through, kept to reuse its storage.
+    std::vector<Ready> dispatching;
+};
+
+}  // namespace tf
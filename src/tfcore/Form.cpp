@@ -1,4 +1,5 @@
 #include "Form.h"
+#include "Application.h"
 
 #define Uses_TProgram
 #define Uses_TDeskTop
@@ -17,7 +18,7 @@ const char* Form::getText() const {
 void Form::setText(const char* text) {
     delete[] title;
     title = newStr(text);
-    frame->drawView();
+    Application::invalidate(frame);
 }
 
 void Form::getBounds(Rectangle* out) const {
@@ -41,7 +42,7 @@ void Form::setControlBox(BOOL value) {
         flags &= ~wfClose;
     }
     if (frame) {
-        frame->drawView();
+        Application::invalidate(frame);
     }
 }
 
@@ -56,7 +57,7 @@ void Form::setMaximizeBox(BOOL value) {
         flags &= ~wfZoom;
     }
     if (frame) {
-        frame->drawView();
+        Application::invalidate(frame);
     }
 }
 
@@ -71,7 +72,7 @@ void Form::setResizable(BOOL value) {
         flags &= ~wfGrow;
     }
     if (frame) {
-        frame->drawView();
+        Application::invalidate(frame);
     }
 }
 
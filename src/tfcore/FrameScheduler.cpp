@@ -0,0 +1,71 @@
+#include "FrameScheduler.h"
+
+namespace tf {
+
+FrameScheduler::FrameScheduler() {}
+
+bool FrameScheduler::defer(TView* view) {
+    invalidationCount++;
+    if (!deferred) {
+        drawCount++;
+        return false;
+    }
+    pending.insert(view);
+    return true;
+}
+
+int32_t FrameScheduler::getTimeout(uint64_t now) const {
+    if (pending.empty()) {
+        return -1;
+    }
+    if (maxFrameRate <= 0) {
+        return 0;
+    }
+    uint64_t next = lastFrame + 1000 / maxFrameRate;
+    return next > now ? static_cast<int32_t>(next - now) : 0;
+}
+
+bool FrameScheduler::render(TGroup* root, uint64_t now, bool force) {
+    if (pending.empty() || (!force && getTimeout(now) > 0)) {
+        return false;
+    }
+
+    size_t remaining = pending.size();
+    if (pending.count(root)) {
+        root->drawView();
+        drawCount++;
+    } else {
+        drawPending(root, &remaining);
+    }
+    pending.clear();
+    lastFrame = now;
+    frameCount++;
+    return true;
+}
+
+// Draws the views under `group` that are in `pending`, and returns false once all of them have been found. A view
+// that is drawn takes its subviews with it, so they aren't looked at.
+bool FrameScheduler::drawPending(TGroup* group, size_t* remaining) {
+    TView* last = group->last;
+    if (last == nullptr) {
+        return true;
+    }
+    TView* view = last;
+    do {
+        view = view->next;
+        if (pending.count(view)) {
+            view->drawView();
+            drawCount++;
+            if (--*remaining == 0) {
+                return false;
+            }
+        } else if (auto subgroup = dynamic_cast<TGroup*>(view)) {
+            if (!drawPending(subgroup, remaining)) {
+                return false;
+            }
+        }
+    } while (view != last);
+    return true;
+}
+
+}  // namespace tf
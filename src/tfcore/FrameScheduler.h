@@ -0,0 +1,65 @@
+#pragma once
+
+#include "common.h"
+
+#include <unordered_set>
+
+#define Uses_TView
+#define Uses_TGroup
+#include <tvision/tv.h>
+
+namespace tf {
+
+// Batches the redraws that setters ask for into frames, for the Application. UI thread only.
+//
+// Drawing is immediate by default: defer() returns false and the caller draws the view at once, as Turbo Vision does.
+// In deferred mode, defer() only records the view, and render() draws each recorded view once per frame, however many
+// times it changed, no more often than the frame rate allows.
+//
+// The recorded views are only looked up, never dereferenced: render() walks the view tree and draws the views it finds
+// in the set. A view that was destroyed in the meantime is no longer in the tree, so it is simply forgotten.
+class FrameScheduler {
+   public:
+    FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    bool getDeferred() const { return deferred; }
+    void setDeferred(bool value) { deferred = value; }
+
+    // Frames per second. 0 draws a frame on every pass of the event loop that has something to draw.
+    int32_t getMaxFrameRate() const { return maxFrameRate; }
+    void setMaxFrameRate(int32_t value) { maxFrameRate = value; }
+
+    // Asks for `view` to be redrawn. Returns true if the redraw was put off to the next frame, or false if the caller
+    // must draw the view now.
+    bool defer(TView* view);
+    bool hasPending() const { return !pending.empty(); }
+
+    // Milliseconds from `now` until render() may draw the next frame, or -1 if nothing is waiting to be drawn.
+    int32_t getTimeout(uint64_t now) const;
+
+    // Draws the recorded views that are under `root` if a frame is due at `now`, or regardless if `force` is set.
+    // Returns whether it drew a frame.
+    bool render(TGroup* root, uint64_t now, bool force);
+
+    // Redraw requests, views drawn, and frames drawn since the start.
+    int64_t getInvalidationCount() const { return invalidationCount; }
+    int64_t getDrawCount() const { return drawCount; }
+    int64_t getFrameCount() const { return frameCount; }
+
+   private:
+    bool drawPending(TGroup* group, size_t* remaining);
+
+    bool deferred{ false };
+    int32_t maxFrameRate{ 60 };
+    std::unordered_set<TView*> pending;
+    uint64_t lastFrame{ 0 };
+
+    int64_t invalidationCount{ 0 };
+    int64_t drawCount{ 0 };
+    int64_t frameCount{ 0 };
+};
+
+}  // namespace tf
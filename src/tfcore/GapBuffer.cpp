@@ -0,0 +1,93 @@
+#include "GapBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace tf {
+
+void GapBuffer::insert(int32_t position, const char* text, int32_t length) {
+    if (length <= 0) {
+        return;
+    }
+    moveGap(position);
+    reserveGap(length);
+    memcpy(bytes.data() + gapStart, text, length);
+    gapStart += length;
+}
+
+void GapBuffer::erase(int32_t position, int32_t count) {
+    if (count <= 0) {
+        return;
+    }
+    // The erased bytes simply join the gap.
+    moveGap(position);
+    gapEnd += count;
+}
+
+void GapBuffer::assign(const char* text, int32_t length) {
+    gapStart = 0;
+    gapEnd = static_cast<int32_t>(bytes.size());
+    insert(0, text, length);
+}
+
+void GapBuffer::clear() {
+    gapStart = 0;
+    gapEnd = static_cast<int32_t>(bytes.size());
+}
+
+void GapBuffer::copy(int32_t position, int32_t count, char* out) const {
+    int32_t before = std::max(0, std::min(count, gapStart - position));
+    if (before > 0) {
+        memcpy(out, bytes.data() + position, before);
+    }
+    if (count > before) {
+        memcpy(out + before, bytes.data() + position + before + (gapEnd - gapStart), count - before);
+    }
+}
+
+bool GapBuffer::equals(int32_t position, const char* text, int32_t length) const {
+    if (length <= 0) {
+        return true;
+    }
+    int32_t before = std::max(0, std::min(length, gapStart - position));
+    return memcmp(bytes.data() + position, text, before) == 0 &&
+        memcmp(bytes.data() + position + before + (gapEnd - gapStart), text + before, length - before) == 0;
+}
+
+const char* GapBuffer::c_str() {
+    moveGap(getLength());
+    reserveGap(1);
+    bytes[gapStart] = '\0';
+    return bytes.data();
+}
+
+void GapBuffer::moveGap(int32_t position) {
+    if (position < gapStart) {
+        int32_t count = gapStart - position;
+        memmove(bytes.data() + gapEnd - count, bytes.data() + position, count);
+        gapStart -= count;
+        gapEnd -= count;
+    } else if (position > gapStart) {
+        int32_t count = position - gapStart;
+        memmove(bytes.data() + gapStart, bytes.data() + gapEnd, count);
+        gapStart += count;
+        gapEnd += count;
+    }
+}
+
+void GapBuffer::reserveGap(int32_t length) {
+    if (gapEnd - gapStart >= length) {
+        return;
+    }
+    // Grow to at least double, so a run of inserts reallocates a logarithmic number of times.
+    int32_t textLength = getLength();
+    size_t newSize = std::max<size_t>({ bytes.size() * 2, static_cast<size_t>(textLength) + length, 16 });
+    int32_t tailLength = static_cast<int32_t>(bytes.size()) - gapEnd;
+    std::vector<char> grown(newSize);
+    std::copy(bytes.begin(), bytes.begin() + gapStart, grown.begin());
+    std::copy(bytes.begin() + gapEnd, bytes.end(), grown.end() - tailLength);
+    bytes.swap(grown);
+    gapEnd = static_cast<int32_t>(newSize) - tailLength;
+}
+
+}  // namespace tf
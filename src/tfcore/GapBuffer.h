@@ -0,0 +1,45 @@
+#pragma once
+
+#include "common.h"
+
+#include <vector>
+
+namespace tf {
+
+// Editable text with the free space kept as a gap at the last edit position. Inserting or erasing next to the previous
+// edit moves no bytes beyond the edit itself; an edit elsewhere first moves the gap there, which costs the distance
+// moved. The buffer grows geometrically and never shrinks on its own.
+//
+// Positions are byte offsets into the text as if the gap were not there.
+class GapBuffer {
+   public:
+    int32_t getLength() const { return static_cast<int32_t>(bytes.size()) - (gapEnd - gapStart); }
+    char at(int32_t position) const {
+        return position < gapStart ? bytes[position] : bytes[position + gapEnd - gapStart];
+    }
+
+    void insert(int32_t position, const char* text, int32_t length);
+    void erase(int32_t position, int32_t count);
+    void assign(const char* text, int32_t length);
+    void clear();
+
+    // Copies bytes [position, position + count) to `out`, reading around the gap.
+    void copy(int32_t position, int32_t count, char* out) const;
+
+    // Whether bytes [position, position + length) equal `text`.
+    bool equals(int32_t position, const char* text, int32_t length) const;
+
+    // The whole text, null-terminated. Moves the gap to the end, so the next edit at the end is still free, but an
+    // edit elsewhere moves it back. The pointer is valid until the next edit.
+    const char* c_str();
+
+   private:
+    void moveGap(int32_t position);
+    void reserveGap(int32_t length);
+
+    std::vector<char> bytes;
+    int32_t gapStart{ 0 };
+    int32_t gapEnd{ 0 };
+};
+
+}  // namespace tf
@@ -0,0 +1,89 @@
+#include "GraphemeMap.h"
+#include "TextMetrics.h"
+
+#include <algorithm>
+
+namespace tf {
+
+GraphemeMap::GraphemeMap() : entries{ Entry{ 0, 0 } } {}
+
+int32_t GraphemeMap::findByte(int32_t position) const {
+    auto it = std::upper_bound(
+        entries.begin(), entries.end(), position, [](int32_t value, const Entry& entry) { return value < entry.byte; });
+    return std::max(0, std::min(static_cast<int32_t>(it - entries.begin()) - 1, getCount()));
+}
+
+int32_t GraphemeMap::findColumn(int32_t column) const {
+    // Zero-width clusters share a column with the cluster after them; the visible one wins.
+    auto it = std::upper_bound(entries.begin(), entries.end(), column, [](int32_t value, const Entry& entry) {
+        return value < entry.column;
+    });
+    return std::max(0, std::min(static_cast<int32_t>(it - entries.begin()) - 1, getCount()));
+}
+
+void GraphemeMap::reset(const GapBuffer& text) {
+    entries.assign(1, Entry{ 0, 0 });
+    update(text, 0, 0, text.getLength());
+}
+
+void GraphemeMap::update(const GapBuffer& text, int32_t position, int32_t oldLength, int32_t newLength) {
+    int32_t length = text.getLength();
+    int32_t delta = newLength - oldLength;
+
+    // Start early: what was inserted or uncovered may be a combining mark that joins the cluster before it, or may
+    // complete a UTF-8 sequence that started up to three bytes back. Deciding where a cluster ends decodes at most one
+    // character past it, so the boundaries before the cluster that holds byte `position - 3` cannot have moved.
+    int32_t first = std::max(0, findByte(std::max(0, position - 3)) - 1);
+    int32_t last = findByte(position + oldLength);
+    if (entries[last].byte < position + oldLength) {
+        last++;
+    }
+
+    // Segment until a new boundary past the edit lands on a shifted old one; from there on segmentation repeats.
+    std::vector<Entry> segmented;
+    int32_t byte = entries[first].byte;
+    int32_t column = entries[first].column;
+    int32_t windowStart = byte;
+    int32_t windowEnd = byte;
+    int32_t blockLength = 256;
+    while (true) {
+        while (entries[last].byte + delta < byte) {
+            last++;
+        }
+        if (byte >= position + newLength && entries[last].byte + delta == byte) {
+            break;
+        }
+
+        // The text is read in blocks that double each time, so a small edit copies little and a reset() few times.
+        // A cluster that runs to the end of a block is read again from a bigger one.
+        int32_t clusterLength;
+        while (true) {
+            int32_t available = windowEnd - byte;
+            if (available >= std::min(64, length - byte)) {
+                clusterLength = nextGrapheme(window.data() + (byte - windowStart), available);
+                if (clusterLength < available || windowEnd == length) {
+                    break;
+                }
+            }
+            blockLength = std::min(blockLength * 2, 1 << 16);
+            windowStart = byte;
+            windowEnd = byte + std::min(std::max(blockLength, available * 2), length - byte);
+            window.resize(windowEnd - windowStart);
+            text.copy(windowStart, windowEnd - windowStart, window.data());
+        }
+
+        segmented.push_back(Entry{ byte, column });
+        column += measureWidth(window.data() + (byte - windowStart), clusterLength);
+        byte += clusterLength;
+    }
+
+    int32_t columnDelta = column - entries[last].column;
+    entries.erase(entries.begin() + first, entries.begin() + last);
+    entries.insert(entries.begin() + first, segmented.begin(), segmented.end());
+    for (auto it = entries.begin() + first + segmented.size(); it != entries.end(); ++it) {
+        it->byte += delta;
+        it->column += columnDelta;
+    }
+}
+
+}  // namespace tf
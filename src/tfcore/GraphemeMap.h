@@ -0,0 +1,47 @@
+#pragma once
+
+#include "common.h"
+#include "GapBuffer.h"
+
+#include <vector>
+
+namespace tf {
+
+// The grapheme cluster boundaries of a GapBuffer's text, each with the screen column the cluster starts at. Going from
+// a cluster index to its byte offset or column is a lookup, and going back from a byte offset or a column is a binary
+// search, so none of them walks the text.
+//
+// The map is kept in step with the text one edit at a time: update() re-segments from the cluster before the edit
+// until the new boundaries line up with the old ones again, then shifts the entries after that by the change in bytes
+// and columns. The last entry is a sentinel at the end of the text.
+class GraphemeMap {
+   public:
+    GraphemeMap();
+
+    int32_t getCount() const { return static_cast<int32_t>(entries.size()) - 1; }
+    int32_t getByteOffset(int32_t index) const { return entries[index].byte; }
+    int32_t getColumn(int32_t index) const { return entries[index].column; }
+
+    // Index of the cluster that contains byte `position`, or getCount() at the end of the text.
+    int32_t findByte(int32_t position) const;
+
+    // Index of the cluster drawn at `column`, counting from the start of the text, or getCount() past the end.
+    int32_t findColumn(int32_t column) const;
+
+    // Segments the whole text.
+    void reset(const GapBuffer& text);
+
+    // Call after bytes [position, position + oldLength) of `text` were replaced by `newLength` bytes.
+    void update(const GapBuffer& text, int32_t position, int32_t oldLength, int32_t newLength);
+
+   private:
+    struct Entry {
+        int32_t byte;
+        int32_t column;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<char> window;
+};
+
+}  // namespace tf
@@ -0,0 +1,484 @@
+#include "History.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tf {
+
+static const char historyMagic[8] = { 'T', 'F', 'H', 'I', 'S', 'T', '0', '1' };
+
+// A record length that sends readers back to the start of the ring. Where fewer bytes than a record header are left
+// before the end, the wrap is implied and no marker is written.
+static const uint32_t wrapMarker = 0xFFFFFFFF;
+
+// Set in the length of a record whose text was added again later. The record stays in the ring until it is evicted.
+static const uint32_t deadFlag = 0x80000000;
+
+static uint32_t recordSize(uint32_t length) {
+    return (static_cast<uint32_t>(sizeof(uint32_t) * 2) + length + 1 + 3) & ~3u;
+}
+
+History::History() : header(&memoryHeader) {
+    initHeader(0);
+}
+
+History::~History() {
+    unmapFile();
+}
+
+const char* History::at(int32_t index) const {
+    return textAt(entries[entries.size() - 1 - index]);
+}
+
+int32_t History::lengthAt(int32_t index) const {
+    return static_cast<int32_t>(recordAt(entries[entries.size() - 1 - index])->length);
+}
+
+int32_t History::getCapacity() const {
+    return static_cast<int32_t>(header->capacity);
+}
+
+void History::setCapacity(int32_t value) {
+    uint32_t capacity = static_cast<uint32_t>(std::max(0, value));
+    if (capacity == header->capacity) {
+        return;
+    }
+    std::vector<std::string> texts = snapshot();
+    if (mapping != nullptr) {
+        std::string path = filePath;
+        std::string error;
+        bool existing;
+        unmapFile();
+        if (!mapFile(path, capacity, false, &existing, &error)) {
+            useMemory(capacity);
+        }
+    } else {
+        useMemory(capacity);
+    }
+    for (const std::string& text : texts) {
+        add(text.data(), static_cast<int32_t>(text.size()));
+    }
+}
+
+void History::add(const char* text, int32_t length) {
+    if (length <= 0 || recordSize(static_cast<uint32_t>(length)) > header->capacity) {
+        return;
+    }
+
+    // `text` may point into the ring, which evicting or overwriting the old copy can clobber.
+    if (text >= ring && text < ring + header->capacity) {
+        std::string copy(text, length);
+        add(copy.data(), length);
+        return;
+    }
+
+    auto it = std::lower_bound(sorted.begin(), sorted.end(), 0u, [&](uint32_t offset, uint32_t) {
+        return compareAt(offset, text, length) < 0;
+    });
+    if (it != sorted.end() && compareAt(*it, text, length) == 0) {
+        uint32_t offset = *it;
+        if (offset == entries.back()) {
+            return;
+        }
+        recordAt(offset)->length |= deadFlag;
+        sorted.erase(it);
+        entries.erase(std::find(entries.begin(), entries.end(), offset));
+    }
+
+    uint32_t size = recordSize(static_cast<uint32_t>(length));
+    if (!makeRoom(size)) {
+        return;
+    }
+    if (header->nextSequence == UINT32_MAX) {
+        renumber();
+    }
+    uint32_t offset = header->tail;
+    Record* record = recordAt(offset);
+    record->length = static_cast<uint32_t>(length);
+    record->sequence = header->nextSequence++;
+    char* destination = ring + offset + sizeof(Record);
+    memcpy(destination, text, length);
+    destination[length] = '\0';
+    header->tail += size;
+    header->used += size;
+
+    entries.push_back(offset);
+    sorted.insert(std::lower_bound(sorted.begin(), sorted.end(), 0u, [&](uint32_t other, uint32_t) {
+        return compareAt(other, text, length) < 0;
+    }), offset);
+}
+
+void History::clear() {
+    initHeader(header->capacity);
+}
+
+int32_t History::findPrefix(const char* prefix, int32_t length, int32_t* out, int32_t max) const {
+    if (max <= 0) {
+        return 0;
+    }
+    auto first = std::lower_bound(sorted.begin(), sorted.end(), 0u, [&](uint32_t offset, uint32_t) {
+        return compareAt(offset, prefix, length) < 0;
+    });
+    std::vector<uint32_t> matches;
+    for (auto it = first; it != sorted.end(); ++it) {
+        const Record* record = recordAt(*it);
+        if (static_cast<int32_t>(record->length) < length || memcmp(textAt(*it), prefix, length) != 0) {
+            break;
+        }
+        matches.push_back(*it);
+    }
+
+    // Newest first. Sequence numbers rise from the oldest entry to the newest, so an entry's index is found by a
+    // binary search of `entries` on its sequence number.
+    int32_t count = std::min(max, static_cast<int32_t>(matches.size()));
+    auto newer = [this](uint32_t a, uint32_t b) { return recordAt(a)->sequence > recordAt(b)->sequence; };
+    std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), newer);
+    for (int32_t i = 0; i < count; i++) {
+        uint32_t sequence = recordAt(matches[i])->sequence;
+        auto position = std::lower_bound(entries.begin(), entries.end(), sequence, [this](uint32_t offset, uint32_t s) {
+            return recordAt(offset)->sequence < s;
+        });
+        out[i] = getCount() - 1 - static_cast<int32_t>(position - entries.begin());
+    }
+    return count;
+}
+
+int History::compareAt(uint32_t offset, const char* text, int32_t length) const {
+    int32_t storedLength = static_cast<int32_t>(recordAt(offset)->length);
+    int result = memcmp(textAt(offset), text, std::min(storedLength, length));
+    if (result != 0) {
+        return result;
+    }
+    return storedLength < length ? -1 : storedLength > length ? 1 : 0;
+}
+
+std::vector<std::string> History::snapshot() const {
+    std::vector<std::string> texts;
+    texts.reserve(entries.size());
+    for (uint32_t offset : entries) {
+        texts.emplace_back(textAt(offset), recordAt(offset)->length);
+    }
+    return texts;
+}
+
+void History::useMemory(uint32_t capacity) {
+    header = &memoryHeader;
+    std::vector<char>(capacity).swap(memory);
+    ring = memory.data();
+    initHeader(capacity);
+}
+
+void History::initHeader(uint32_t capacity) {
+    memcpy(header->magic, historyMagic, sizeof(historyMagic));
+    header->capacity = capacity;
+    header->head = 0;
+    header->tail = 0;
+    header->used = 0;
+    header->nextSequence = 0;
+    header->reserved = 0;
+    entries.clear();
+    sorted.clear();
+}
+
+bool History::skipWrap(uint32_t offset) const {
+    return header->capacity - offset < sizeof(Record) || recordAt(offset)->length == wrapMarker;
+}
+
+bool History::makeRoom(uint32_t size) {
+    while (true) {
+        uint32_t head = header->head;
+        uint32_t tail = header->tail;
+        if (header->used == 0) {
+            header->head = 0;
+            header->tail = 0;
+            return size <= header->capacity;
+        }
+        if (tail > head) {
+            if (tail + size <= header->capacity) {
+                return true;
+            }
+            if (size <= head) {
+                // Wrap around, counting the unused end of the ring as used until the head passes it.
+                if (!skipWrap(tail)) {
+                    recordAt(tail)->length = wrapMarker;
+                }
+                header->used += header->capacity - tail;
+                header->tail = 0;
+                return true;
+            }
+        } else if (tail < head && tail + size <= head) {
+            return true;
+        }
+        evictOldest();
+    }
+}
+
+void History::evictOldest() {
+    uint32_t head = header->head;
+    if (skipWrap(head)) {
+        header->used -= header->capacity - head;
+        head = 0;
+    }
+    if (header->used > 0) {
+        Record* record = recordAt(head);
+        uint32_t size = recordSize(record->length & ~deadFlag);
+        if ((record->length & deadFlag) == 0) {
+            entries.pop_front();
+            removeFromSorted(head);
+        }
+        head += size;
+        header->used -= size;
+    }
+    if (head == header->capacity) {
+        head = 0;
+    }
+    header->head = head;
+    if (header->used == 0) {
+        header->head = 0;
+        header->tail = 0;
+    }
+}
+
+void History::removeFromSorted(uint32_t offset) {
+    const char* text = textAt(offset);
+    int32_t length = static_cast<int32_t>(recordAt(offset)->length);
+    auto it = std::lower_bound(sorted.begin(), sorted.end(), 0u, [&](uint32_t other, uint32_t) {
+        return compareAt(other, text, length) < 0;
+    });
+    sorted.erase(it);
+}
+
+void History::renumber() {
+    // Only live records need their order kept; dead ones are never compared.
+    uint32_t sequence = 0;
+    for (uint32_t offset : entries) {
+        recordAt(offset)->sequence = sequence++;
+    }
+    header->nextSequence = sequence;
+}
+
+bool History::buildIndexes() {
+    // The header and the records come from a file, so check everything before trusting it.
+    entries.clear();
+    sorted.clear();
+    uint32_t capacity = header->capacity;
+    if (header->head >= std::max(capacity, 1u) || header->tail > capacity || header->used > capacity ||
+        (header->head | header->tail) % 4 != 0) {
+        return false;
+    }
+    uint32_t offset = header->head;
+    uint32_t remaining = header->used;
+    while (remaining > 0) {
+        if (skipWrap(offset)) {
+            if (capacity - offset > remaining) {
+                return false;
+            }
+            remaining -= capacity - offset;
+            offset = 0;
+            continue;
+        }
+        const Record* record = recordAt(offset);
+        uint32_t length = record->length & ~deadFlag;
+        uint32_t size = recordSize(length);
+        if (length > capacity || size > remaining || size > capacity - offset || textAt(offset)[length] != '\0') {
+            return false;
+        }
+        if ((record->length & deadFlag) == 0) {
+            if (!entries.empty() && recordAt(entries.back())->sequence >= record->sequence) {
+                return false;
+            }
+            entries.push_back(offset);
+        }
+        offset += size;
+        remaining -= size;
+    }
+    if (offset != header->tail && !(offset == capacity && header->tail == 0)) {
+        return false;
+    }
+    if (!entries.empty() && recordAt(entries.back())->sequence >= header->nextSequence) {
+        return false;
+    }
+
+    sorted.assign(entries.begin(), entries.end());
+    std::sort(sorted.begin(), sorted.end(), [this](uint32_t a, uint32_t b) {
+        return compareAt(a, textAt(b), static_cast<int32_t>(recordAt(b)->length)) < 0;
+    });
+    for (size_t i = 1; i < sorted.size(); i++) {
+        if (compareAt(sorted[i - 1], textAt(sorted[i]), static_cast<int32_t>(recordAt(sorted[i])->length)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool History::openFile(const char* path, std::string* error) {
+    std::vector<std::string> texts = snapshot();
+    uint32_t capacity = header->capacity;
+    std::string oldPath = filePath;
+    bool wasMapped = mapping != nullptr;
+    if (wasMapped) {
+        unmapFile();
+    }
+
+    bool existing;
+    if (!mapFile(path, capacity, true, &existing, error)) {
+        // Put back what was there: the old file, or failing that the same entries on the heap.
+        bool reopened = false;
+        if (wasMapped) {
+            std::string ignored;
+            reopened = mapFile(oldPath, capacity, true, &existing, &ignored) && buildIndexes();
+        }
+        if (!reopened) {
+            useMemory(capacity);
+            for (const std::string& text : texts) {
+                add(text.data(), static_cast<int32_t>(text.size()));
+            }
+        }
+        return false;
+    }
+    if (existing && buildIndexes()) {
+        std::vector<char>().swap(memory);
+        return true;
+    }
+
+    // A new file, or one that is damaged: start it with the current entries.
+    initHeader(capacity);
+    for (const std::string& text : texts) {
+        add(text.data(), static_cast<int32_t>(text.size()));
+    }
+    std::vector<char>().swap(memory);
+    return true;
+}
+
+void History::closeFile() {
+    if (mapping == nullptr) {
+        return;
+    }
+    std::vector<std::string> texts = snapshot();
+    uint32_t capacity = header->capacity;
+    unmapFile();
+    useMemory(capacity);
+    for (const std::string& text : texts) {
+        add(text.data(), static_cast<int32_t>(text.size()));
+    }
+}
+
+bool History::mapFile(
+    const std::string& path,
+    uint32_t capacity,
+    bool keepExisting,
+    bool* existing,
+    std::string* error) {
+    // Keep a file that already holds a history of a consistent size; otherwise size it for `capacity`.
+    Header fileHeader{};
+    *existing = false;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        *error = "Unable to open the history file \"" + path + "\".";
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    DWORD read = 0;
+    if (keepExisting && GetFileSizeEx(file, &fileSize) &&
+        ReadFile(file, &fileHeader, sizeof(fileHeader), &read, nullptr) && read == sizeof(fileHeader) &&
+        memcmp(fileHeader.magic, historyMagic, sizeof(historyMagic)) == 0 &&
+        static_cast<uint64_t>(fileSize.QuadPart) == sizeof(Header) + static_cast<uint64_t>(fileHeader.capacity) &&
+        fileHeader.capacity <= INT32_MAX) {
+        *existing = true;
+        capacity = fileHeader.capacity;
+    }
+    size_t size = sizeof(Header) + capacity;
+    LARGE_INTEGER newSize;
+    newSize.QuadPart = static_cast<LONGLONG>(size);
+    if (!*existing && (!SetFilePointerEx(file, newSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file))) {
+        CloseHandle(file);
+        *error = "Unable to resize the history file \"" + path + "\".";
+        return false;
+    }
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    void* view = map != nullptr ? MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, size) : nullptr;
+    if (view == nullptr) {
+        if (map != nullptr) {
+            CloseHandle(map);
+        }
+        CloseHandle(file);
+        *error = "Unable to map the history file \"" + path + "\".";
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = map;
+#else
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        *error = "Unable to open the history file \"" + path + "\".";
+        return false;
+    }
+    struct stat status;
+    if (keepExisting && fstat(fd, &status) == 0 &&
+        pread(fd, &fileHeader, sizeof(fileHeader), 0) == static_cast<ssize_t>(sizeof(fileHeader)) &&
+        memcmp(fileHeader.magic, historyMagic, sizeof(historyMagic)) == 0 &&
+        static_cast<uint64_t>(status.st_size) == sizeof(Header) + static_cast<uint64_t>(fileHeader.capacity) &&
+        fileHeader.capacity <= INT32_MAX) {
+        *existing = true;
+        capacity = fileHeader.capacity;
+    }
+    size_t size = sizeof(Header) + capacity;
+    if (!*existing && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        *error = "Unable to resize the history file \"" + path + "\".";
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        close(fd);
+        *error = "Unable to map the history file \"" + path + "\".";
+        return false;
+    }
+    fileDescriptor = fd;
+#endif
+    mapping = view;
+    mappingSize = size;
+    filePath = path;
+    header = static_cast<Header*>(view);
+    ring = static_cast<char*>(view) + sizeof(Header);
+    if (!*existing) {
+        initHeader(capacity);
+    }
+    return true;
+}
+
+void History::unmapFile() {
+    if (mapping == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(mapping, mappingSize);
+    close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    filePath.clear();
+    header = &memoryHeader;
+    ring = memory.data();
+}
+
+}  // namespace tf
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "common.h"
+
+#include <deque>
+#include <vector>
+
+namespace tf {
+
+// Previously entered text for one TextBox, newest first, within a fixed memory budget. Replaces Turbo Vision's
+// THistory, whose entries for all fields share one small global block that is searched linearly.
+//
+// Entries live in a ring of `capacity` bytes as length-prefixed records. Adding an entry that does not fit evicts the
+// oldest ones; adding text that is already there moves it to the front. A second index keeps the entries sorted by
+// text, so the entries that start with a prefix are found with a binary search and read in order from there.
+//
+// The ring can live in a memory-mapped file instead of the heap. Edits then go straight to the file, which the
+// operating system writes back, and opening the file again maps it and walks the record headers to rebuild the
+// indexes; no text is parsed or copied.
+class History {
+   public:
+    History();
+    ~History();
+
+    History(const History&) = delete;
+    History& operator=(const History&) = delete;
+
+    int32_t getCount() const { return static_cast<int32_t>(entries.size()); }
+
+    // Entry `index`, counting from the newest. Null-terminated, and valid until the next change to the history.
+    const char* at(int32_t index) const;
+    int32_t lengthAt(int32_t index) const;
+
+    // Capacity in bytes, including up to twelve bytes of overhead per entry. 0, the default, keeps no history.
+    // Changing it keeps the newest entries that fit.
+    int32_t getCapacity() const;
+    void setCapacity(int32_t value);
+
+    // Adds text as the newest entry. Empty text and text longer than the capacity allows are ignored.
+    void add(const char* text, int32_t length);
+    void clear();
+
+    // Writes to `out` the indexes of up to `max` entries that start with `prefix`, newest first, and returns how many.
+    int32_t findPrefix(const char* prefix, int32_t length, int32_t* out, int32_t max) const;
+
+    // Moves the history into the file at `path`. An existing history file's entries and capacity replace the current
+    // ones; anything else at `path` is overwritten with the current entries. Returns false and describes the problem
+    // in `error` if the file cannot be opened or mapped, leaving the history as it was.
+    bool openFile(const char* path, std::string* error);
+
+    // Moves the history back to the heap, keeping its entries, and closes the file.
+    void closeFile();
+
+   private:
+    // Stored at the start of the file, or in `memoryHeader` when there is no file.
+    struct Header {
+        char magic[8];
+        uint32_t capacity;
+        uint32_t head;
+        uint32_t tail;
+        uint32_t used;
+        uint32_t nextSequence;
+        uint32_t reserved;
+    };
+
+    // Precedes each entry's text in the ring. Records are padded to four bytes, and text is null-terminated.
+    struct Record {
+        uint32_t length;
+        uint32_t sequence;
+    };
+
+    Record* recordAt(uint32_t offset) const { return reinterpret_cast<Record*>(ring + offset); }
+    const char* textAt(uint32_t offset) const { return ring + offset + sizeof(Record); }
+    int compareAt(uint32_t offset, const char* text, int32_t length) const;
+
+    std::vector<std::string> snapshot() const;
+    void useMemory(uint32_t capacity);
+    void initHeader(uint32_t capacity);
+    bool skipWrap(uint32_t offset) const;
+    bool makeRoom(uint32_t size);
+    void evictOldest();
+    void removeFromSorted(uint32_t offset);
+    void renumber();
+    bool buildIndexes();
+    bool mapFile(const std::string& path, uint32_t capacity, bool keepExisting, bool* existing, std::string* error);
+    void unmapFile();
+
+    Header memoryHeader{};
+    std::vector<char> memory;
+    Header* header;
+    char* ring{ nullptr };
+
+    // Offsets of the live records, oldest first, and the same offsets sorted by text.
+    std::deque<uint32_t> entries;
+    std::vector<uint32_t> sorted;
+
+#ifdef _WIN32
+    void* fileHandle{ nullptr };
+    void* mappingHandle{ nullptr };
+#else
+    int fileDescriptor{ -1 };
+#endif
+    void* mapping{ nullptr };
+    size_t mappingSize{ 0 };
+    std::string filePath;
+};
+
+}  // namespace tf
@@ -0,0 +1,95 @@
+#include "ItemComparer.h"
+
+#include <algorithm>
+
+namespace tf {
+
+static inline unsigned char foldCase(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return u >= 'A' && u <= 'Z' ? u + ('a' - 'A') : u;
+}
+
+static inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static int compareOrdinal(const char* a, int32_t aLength, const char* b, int32_t bLength) {
+    int result = memcmp(a, b, std::min(aLength, bLength));
+    if (result != 0) {
+        return result < 0 ? -1 : 1;
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+static int compareIgnoreCase(const char* a, int32_t aLength, const char* b, int32_t bLength) {
+    int32_t length = std::min(aLength, bLength);
+    for (int32_t i = 0; i < length; i++) {
+        unsigned char x = foldCase(a[i]);
+        unsigned char y = foldCase(b[i]);
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+static int compareNatural(const char* a, int32_t aLength, const char* b, int32_t bLength) {
+    int32_t i = 0;
+    int32_t j = 0;
+    while (i < aLength && j < bLength) {
+        if (isDigit(a[i]) && isDigit(b[j])) {
+            // Compare the numbers without converting them, so runs of any length work: skip leading zeros, then the
+            // longer run is the larger number, and runs of equal length compare digit by digit.
+            while (i < aLength && a[i] == '0') {
+                i++;
+            }
+            while (j < bLength && b[j] == '0') {
+                j++;
+            }
+            int32_t aEnd = i;
+            while (aEnd < aLength && isDigit(a[aEnd])) {
+                aEnd++;
+            }
+            int32_t bEnd = j;
+            while (bEnd < bLength && isDigit(b[bEnd])) {
+                bEnd++;
+            }
+            if (aEnd - i != bEnd - j) {
+                return aEnd - i < bEnd - j ? -1 : 1;
+            }
+            int result = memcmp(a + i, b + j, aEnd - i);
+            if (result != 0) {
+                return result < 0 ? -1 : 1;
+            }
+            i = aEnd;
+            j = bEnd;
+            continue;
+        }
+
+        unsigned char x = foldCase(a[i]);
+        unsigned char y = foldCase(b[j]);
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+        i++;
+        j++;
+    }
+    int32_t aRest = aLength - i;
+    int32_t bRest = bLength - j;
+    return aRest < bRest ? -1 : (aRest > bRest ? 1 : 0);
+}
+
+int compareItems(SortOrder order, const char* a, int32_t aLength, const char* b, int32_t bLength) {
+    switch (order) {
+        case SortOrder_Ordinal:
+            return compareOrdinal(a, aLength, b, bLength);
+        case SortOrder_IgnoreCase:
+            return compareIgnoreCase(a, aLength, b, bLength);
+        case SortOrder_Natural:
+            return compareNatural(a, aLength, b, bLength);
+        default:
+            return 0;
+    }
+}
+
+}  // namespace tf
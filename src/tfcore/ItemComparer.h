@@ -0,0 +1,21 @@
+#pragma once
+
+#include "common.h"
+
+namespace tf {
+
+// Matches `ListBoxSortOrder` in `src\TerminalForms\ListBox.cs`
+enum SortOrder {
+    SortOrder_None = 0,
+    SortOrder_Ordinal,
+    SortOrder_IgnoreCase,
+    SortOrder_Natural,
+};
+
+// Compares two UTF-8 strings like strcmp(), in the given order.
+// SortOrder_Ordinal compares bytes, like TStringCollection::compare(). SortOrder_IgnoreCase folds ASCII letters.
+// SortOrder_Natural also folds ASCII letters and compares runs of digits by their numeric value, so "item9" sorts
+// before "item10".
+int compareItems(SortOrder order, const char* a, int32_t aLength, const char* b, int32_t bLength);
+
+}  // namespace tf
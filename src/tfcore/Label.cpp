@@ -1,4 +1,6 @@
 #include "Label.h"
+#include "Application.h"
+#include "TextMetrics.h"
 
 #define Uses_TRect
 #define Uses_TLabel
@@ -8,6 +10,9 @@
 #define Uses_TInputLine  // For hotKey function
 #include <tvision/tv.h>
 
+#include <algorithm>
+#include <cstring>
+
 #if !defined(__CTYPE_H)
 #include <ctype.h>
 #endif  // __CTYPE_H
@@ -18,6 +23,112 @@ Label::Label() : TLabel(TRect(2, 2, 12, 3), "Label", nullptr) {}
 
 Label::Label(const TRect& bounds, TStringView text) : TLabel(bounds, text, nullptr) {}
 
+// Width of label text, where tildes only switch the hotkey highlight and take no room.
+static int32_t labelWidth(const char* text, int32_t length, bool mnemonics) {
+    if (!mnemonics) {
+        return measureWidth(text, length);
+    }
+    int32_t width = 0;
+    int32_t start = 0;
+    for (int32_t i = 0; i <= length; i++) {
+        if (i == length || text[i] == '~') {
+            width += measureWidth(text + start, i - start);
+            start = i + 1;
+        }
+    }
+    return width;
+}
+
+// Length in bytes of the longest prefix of label text that fits in `columns`, counting tildes as labelWidth() does.
+static int32_t labelFit(const char* text, int32_t length, int32_t columns, bool mnemonics) {
+    int32_t start = 0;
+    for (int32_t i = 0; i <= length; i++) {
+        if (i == length || (mnemonics && text[i] == '~')) {
+            int32_t fit = fitWidth(text + start, i - start, columns);
+            if (fit < i - start) {
+                return start + fit;
+            }
+            columns -= measureWidth(text + start, i - start);
+            start = i + 1;
+        }
+    }
+    return length;
+}
+
+void Label::draw() {
+    // A single row is left to TLabel, which cuts the text off at the edge.
+    if (size.y <= 1) {
+        TLabel::draw();
+        return;
+    }
+    if (wrapSize.x != size.x || wrapSize.y != size.y) {
+        wrap();
+    }
+
+    TAttrPair color = getColor(light ? 0x0402 : 0x0301);
+    for (int32_t y = 0; y < size.y; y++) {
+        TDrawBuffer b;
+        b.moveChar(0, ' ', color, size.x);
+        if (y < static_cast<int32_t>(lines.size())) {
+            TStringView line(text + lines[y].start, lines[y].length);
+            if (useMnemonic) {
+                b.moveCStr(1, line, color);
+            } else {
+                b.moveStr(1, line, color);
+            }
+        }
+        writeLine(0, y, size.x, 1, b);
+    }
+}
+
+void Label::wrap() {
+    // As TStaticText: lines break at line feeds, and at the last space that fits; a word wider than the label is cut.
+    // Spaces where a line wraps are dropped, but a line after a line feed keeps its indent. Only rows that can be seen
+    // are made.
+    lines.clear();
+    wrapSize = size;
+    const char* s = text != nullptr ? text : "";
+    int32_t length = static_cast<int32_t>(strlen(s));
+    int32_t columns = std::max(1, size.x - 1);
+    bool mnemonics = useMnemonic != 0;
+    int32_t p = 0;
+    while (p < length && static_cast<int32_t>(lines.size()) < size.y) {
+        int32_t end = p;
+        int32_t width = 0;
+        int32_t q = p;
+        while (q < length && s[q] != '\n') {
+            int32_t wordStart = q;
+            while (q < length && s[q] == ' ') {
+                q++;
+            }
+            while (q < length && s[q] != ' ' && s[q] != '\n') {
+                q++;
+            }
+            int32_t wordWidth = labelWidth(s + wordStart, q - wordStart, mnemonics);
+            if (width + wordWidth > columns) {
+                if (end == p) {
+                    end = p + std::max(1, labelFit(s + p, q - p, columns, mnemonics));
+                    while (end < length && (static_cast<unsigned char>(s[end]) & 0xC0) == 0x80) {
+                        end++;
+                    }
+                }
+                break;
+            }
+            width += wordWidth;
+            end = q;
+        }
+        lines.push_back({ p, end - p });
+        p = end;
+        if (p < length && s[p] == '\n') {
+            p++;
+        } else {
+            while (p < length && s[p] == ' ') {
+                p++;
+            }
+        }
+    }
+}
+
 void Label::handleEvent(TEvent& event) {
     // Call TStaticText::handleEvent first to handle basic text display
     TStaticText::handleEvent(event);
@@ -56,9 +167,14 @@ const char* Label::getText() const {
 }
 
 void Label::setText(const char* newText) {
+    // Dashboards set the same text over and over; only a real change is worth a reallocation and a redraw.
+    if (text != nullptr && strcmp(text, newText) == 0) {
+        return;
+    }
     delete[] const_cast<char*>(text);
     const_cast<const char*&>(text) = newStr(newText);
-    drawView();
+    wrapSize = TPoint{ -1, -1 };
+    Application::invalidate(this);
 }
 
 BOOL Label::getUseMnemonic() const {
@@ -72,7 +188,8 @@ void Label::setUseMnemonic(BOOL value) {
     } else {
         options &= ~(ofPreProcess | ofPostProcess);
     }
-    drawView();
+    wrapSize = TPoint{ -1, -1 };
+    Application::invalidate(this);
 }
 
 }  // namespace tf
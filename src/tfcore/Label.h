@@ -5,16 +5,21 @@
 #define Uses_TLabel
 #include <tvision/tv.h>
 
+#include <vector>
+
 namespace tf {
 
+// A label more than one row high wraps its text at spaces and line breaks, which TLabel does not. The rows are worked
+// out once and kept until the text or the size changes, rather than on every draw as TStaticText does.
 class Label : public TLabel {
    public:
     Label();
     Label(const TRect& bounds, TStringView text);
 
+    virtual void draw() override;
     virtual void handleEvent(TEvent& event) override;
 
-    // Text property methods
+    // Text property methods. Setting the text it already has does nothing, not even a redraw.
     using TStaticText::getText;  // Bring base class overload into scope
     const char* getText() const;
     void setText(const char* text);
@@ -24,7 +29,19 @@ class Label : public TLabel {
     void setUseMnemonic(BOOL value);
 
    private:
+    // A row of wrapped text: a byte range of `text`.
+    struct Line {
+        int32_t start;
+        int32_t length;
+    };
+
+    void wrap();
+
     BOOL useMnemonic = 1;  // Default to true like Windows Forms
+
+    // The wrapped rows, for the size in `wrapSize`. A negative width means the text changed since they were made.
+    std::vector<Line> lines;
+    TPoint wrapSize{ -1, -1 };
 };
 
 template <>
@@ -1,14 +1,21 @@
 #include "ListBox.h"
+#include "Application.h"
+#include "TextMetrics.h"
 
 #define Uses_TRect
 #define Uses_TListBox
 #define Uses_TScrollBar
-#define Uses_TStringCollection
+#define Uses_TDrawBuffer
+#define Uses_TEvent
+#define Uses_TKeys
 #include <tvision/tv.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace tf {
 
-ListBox::ListBox() : TListBox(TRect(2, 2, 22, 8), 1, nullptr), ownedScrollBar(nullptr), stringItems(nullptr) {
+ListBox::ListBox() : TListBox(TRect(2, 2, 22, 8), 1, nullptr), ownedScrollBar(nullptr) {
     // Create a vertical scrollbar on the right edge
     TRect scrollBarBounds(size.x - 1, 0, size.x, size.y);
     ownedScrollBar = new TScrollBar(scrollBarBounds);
@@ -21,40 +28,476 @@ ListBox::ListBox() : TListBox(TRect(2, 2, 22, 8), 1, nullptr), ownedScrollBar(nu
     short arStep = 1;
     vScrollBar->setStep(pgStep, arStep);
 
-    // Create empty string collection
-    stringItems = new TStringCollection(10, 5);
-    items = stringItems;
+    // Items live in itemStore rather than a TStringCollection; TListBox::items stays null.
+    items = nullptr;
 
-    // Start with no selection
-    focused = -1;
+    // Start with no selection. TListViewer's own `focused`/`range` stay at zero; see ListBox.h.
+    focused = 0;
     range = 0;
 }
 
 ListBox::~ListBox() {
-    // TListBox::~TListBox does not delete items, so we must
-    // Note: vScrollBar is not owned by TListBox either
+    // vScrollBar is not owned by TListBox
     delete ownedScrollBar;
     ownedScrollBar = nullptr;
     vScrollBar = nullptr;
+}
 
-    // stringItems is pointed to by items, delete via stringItems
-    delete stringItems;
-    stringItems = nullptr;
-    items = nullptr;
+void ListBox::draw() {
+    // Port of TListViewer::draw() for a single column with 32-bit indices.
+    // Rows are in ascending item order, so one walk through the selected ranges covers the whole view.
+    // A full redraw fetches every row again, in case a virtual source changed its text.
+    rowTexts.clear();
+    int32_t selectedRange = multiSelect && topIndex < rowCount ? selection.findRange(getSourceIndex(topIndex)) : 0;
+    for (short i = 0; i < size.y; i++) {
+        int64_t item = static_cast<int64_t>(topIndex) + i;
+        bool selected = item < rowCount && focusedIndex == item;
+        if (multiSelect && item < rowCount) {
+            int32_t source = getSourceIndex(static_cast<int32_t>(item));
+            while (selectedRange < selection.getRangeCount() && selection.getRange(selectedRange).end <= source) {
+                selectedRange++;
+            }
+            selected = selectedRange < selection.getRangeCount() && selection.getRange(selectedRange).start <= source;
+        }
+        drawLine(i, selected);
+    }
+
+    dirtyRows.clear();
+    rowsInvalidated = false;
 }
 
-void ListBox::selectItem(short item) {
-    // selectItem is called on double-click or Enter/Space
-    // This fires the ItemActivated event
-    TListBox::selectItem(item);
-    itemActivatedEventHandler();
+void ListBox::drawLine(short y, bool selected) {
+    TAttrPair normalColor, selectedColor, focusedColor, color;
+    bool active = (state & (sfSelected | sfActive)) == (sfSelected | sfActive);
+    if (active) {
+        normalColor = getColor(1);
+        focusedColor = getColor(3);
+        selectedColor = getColor(4);
+    } else {
+        normalColor = getColor(2);
+        selectedColor = getColor(4);
+    }
+
+    int64_t item = static_cast<int64_t>(topIndex) + y;
+    if (active && focusedIndex == item && rowCount > 0) {
+        color = focusedColor;
+        setCursor(checkBoxes ? 2 : 1, y);
+    } else if (selected) {
+        color = selectedColor;
+    } else {
+        color = normalColor;
+    }
+
+    short colWidth = size.x + 1;
+    TDrawBuffer b;
+    b.moveChar(0, ' ', color, colWidth);
+    if (item < rowCount && checkBoxes) {
+        // Drawn like TCheckBoxes: the box, a space, then the text.
+        b.moveStr(1, checkedItems.get(getSourceIndex(static_cast<int32_t>(item))) ? "[X]" : "[ ]", color);
+        b.moveStr(5, getRowText(y), color, colWidth);
+    } else if (item < rowCount) {
+        b.moveStr(1, getRowText(y), color, colWidth);
+    } else if (y == 0) {
+        b.moveStr(1, "<empty>", getColor(1));
+    }
+    b.moveChar(colWidth - 1, '\xB3', getColor(5), 1);
+    writeLine(0, y, size.x, 1, b);
+    cellsWritten += size.x;
+}
+
+void ListBox::invalidateRow(int32_t row) {
+    // Rows outside the view need no repaint, but the change is still a row-sized one.
+    rowsInvalidated = true;
+    if (row >= topIndex && row < static_cast<int64_t>(topIndex) + size.y &&
+        std::find(dirtyRows.begin(), dirtyRows.end(), row) == dirtyRows.end()) {
+        dirtyRows.push_back(row);
+    }
+}
+
+void ListBox::invalidateItems(int32_t index, int32_t count) {
+    int64_t lastRow = std::min<int64_t>(static_cast<int64_t>(topIndex) + size.y, rowCount);
+    for (int32_t row = topIndex; row < lastRow; row++) {
+        int32_t source = getSourceIndex(row);
+        if (source >= index && source - index < count) {
+            invalidateRow(row);
+        }
+    }
+    rowsInvalidated = true;
+}
+
+void ListBox::drawDirtyRows() {
+    // A deferred frame draws the whole view, so the rows needn't be tracked.
+    if (Application::deferDraw(this)) {
+        dirtyRows.clear();
+        rowsInvalidated = false;
+        return;
+    }
+
+    // Changes that did not say which rows they touched, such as a structural change, repaint everything.
+    if (!rowsInvalidated) {
+        drawView();
+        return;
+    }
+    if (exposed()) {
+        int64_t scrolled = static_cast<int64_t>(topIndex) - rowTextTop;
+        if (scrolled <= -size.y || scrolled >= size.y) {
+            // Nothing on screen stays in view.
+            drawView();
+            return;
+        }
+        if (scrolled != 0) {
+            // Every row moved, but the rows that stay in view keep their text; only the rows scrolled in are fetched.
+            // A view cannot scroll the terminal itself: Turbo Vision flushes by comparing each cell with the frame it
+            // sent last, and a scroll region would leave that frame stale. That comparison is what keeps the output
+            // small, since a row that moved is sent only where it differs from the row that was there before.
+            for (short y = 0; y < size.y; y++) {
+                drawLine(y, isRowSelected(topIndex + y));
+            }
+        } else {
+            for (int32_t row : dirtyRows) {
+                if (row >= topIndex && row < static_cast<int64_t>(topIndex) + size.y) {
+                    drawLine(static_cast<short>(row - topIndex), isRowSelected(row));
+                }
+            }
+        }
+    }
+    dirtyRows.clear();
+    rowsInvalidated = false;
+}
+
+const char* ListBox::getRowText(short y) {
+    // The cache follows the view: rows that scrolled out are dropped, and rows that scrolled in start out unfetched.
+    int64_t scrolled = static_cast<int64_t>(topIndex) - rowTextTop;
+    if (rowTexts.size() != static_cast<size_t>(size.y) || rowTextWidth != size.x || scrolled <= -size.y ||
+        scrolled >= size.y) {
+        rowTexts.assign(size.y, RowText{});
+        rowTextWidth = size.x;
+    } else if (scrolled > 0) {
+        std::rotate(rowTexts.begin(), rowTexts.begin() + scrolled, rowTexts.end());
+        std::for_each(rowTexts.end() - scrolled, rowTexts.end(), [](RowText& row) { row.fetched = false; });
+    } else if (scrolled < 0) {
+        std::rotate(rowTexts.rbegin(), rowTexts.rbegin() - scrolled, rowTexts.rend());
+        std::for_each(rowTexts.begin(), rowTexts.begin() - scrolled, [](RowText& row) { row.fetched = false; });
+    }
+    rowTextTop = topIndex;
+
+    // Text is cut to the columns between the margin and the separator when fetched, so drawing it measures nothing.
+    // Stored items already know their width; only those too wide to fit are walked to find the cut.
+    RowText& row = rowTexts[y];
+    if (!row.fetched) {
+        int32_t columns = std::max(0, size.x - (checkBoxes ? 5 : 1));
+        int32_t index = getSourceIndex(topIndex + y);
+        if (virtualTextFunction == nullptr) {
+            const char* text = itemStore.at(index);
+            int32_t length = itemStore.lengthAt(index);
+            row.text.assign(text, itemStore.widthAt(index) <= columns ? length : fitWidth(text, length, columns));
+        } else {
+            // Most rows fit the stack buffer. The provider returns the full length, like snprintf, so a longer row is
+            // fetched again whole; cutting it at the buffer could split a UTF-8 sequence that fitWidth() would keep.
+            char text[256];
+            int32_t length = getItemText(index, text, sizeof(text));
+            if (length < static_cast<int32_t>(sizeof(text))) {
+                row.text.assign(text, fitWidth(text, static_cast<int32_t>(strlen(text)), columns));
+            } else {
+                std::string whole(static_cast<size_t>(length) + 1, '\0');
+                getItemText(index, &whole[0], length + 1);
+                const char* wholeText = whole.c_str();
+                row.text.assign(wholeText, fitWidth(wholeText, static_cast<int32_t>(strlen(wholeText)), columns));
+            }
+        }
+        row.fetched = true;
+    }
+    return row.text.c_str();
+}
+
+bool ListBox::isRowSelected(int32_t row) const {
+    if (row < 0 || row >= rowCount) {
+        return false;
+    }
+    return multiSelect ? selection.contains(getSourceIndex(row)) : row == focusedIndex;
+}
+
+void ListBox::handleEvent(TEvent& event) {
+    // Port of TListViewer::handleEvent() for a single column with 32-bit indices.
+    // TListViewer::handleEvent() is skipped on purpose; it would move the `short` state.
+    TView::handleEvent(event);
+
+    if (event.what == evMouseDown) {
+        // In multi-select mode a plain click selects one item and dragging selects the rows passed over, Shift+click
+        // extends from the anchor, and Ctrl+click toggles the clicked item.
+        bool toggle = multiSelect && (event.mouse.controlKeyState & kbCtrlShift) != 0;
+        bool extend = (event.mouse.controlKeyState & kbShift) != 0;
+        const int32_t mouseAutosToSkip = 4;
+        int64_t oldItem = focusedIndex;
+        int64_t newItem = oldItem;
+        TPoint mouse = makeLocal(event.mouse.where);
+        if (mouseInView(event.mouse.where)) {
+            newItem = static_cast<int64_t>(topIndex) + mouse.y;
+        }
+
+        // Pressing and releasing on the same check box toggles it.
+        int64_t checkItem = checkBoxes && mouse.x >= 1 && mouse.x <= 3 ? newItem : -1;
+        int32_t count = 0;
+        do {
+            if (newItem != oldItem) {
+                focusIndexNum(newItem);
+                if (multiSelect && !toggle) {
+                    selectToFocus(extend);
+                    extend = true;
+                }
+                drawDirtyRows();
+            }
+            oldItem = newItem;
+            mouse = makeLocal(event.mouse.where);
+            if (mouseInView(event.mouse.where)) {
+                newItem = static_cast<int64_t>(topIndex) + mouse.y;
+            } else {
+                if (event.what == evMouseAuto) {
+                    count++;
+                }
+                if (count == mouseAutosToSkip) {
+                    count = 0;
+                    if (mouse.y < 0) {
+                        newItem = static_cast<int64_t>(focusedIndex) - 1;
+                    } else if (mouse.y >= size.y) {
+                        newItem = static_cast<int64_t>(focusedIndex) + 1;
+                    }
+                }
+            }
+            if (event.mouse.eventFlags & meDoubleClick) {
+                break;
+            }
+        } while (mouseEvent(event, evMouseMove | evMouseAuto));
+        focusIndexNum(newItem);
+        if (multiSelect && rowCount > 0) {
+            if (toggle) {
+                toggleFocused();
+            } else {
+                selectToFocus(extend);
+            }
+        }
+        // `event` now holds the button release, which may be elsewhere than the last move the loop looked at.
+        mouse = makeLocal(event.mouse.where);
+        if (checkItem >= 0 && checkItem < rowCount && mouseInView(event.mouse.where) &&
+            static_cast<int64_t>(topIndex) + mouse.y == checkItem && mouse.x >= 1 && mouse.x <= 3) {
+            toggleItemChecked(getSourceIndex(static_cast<int32_t>(checkItem)));
+        }
+        drawDirtyRows();
+        if ((event.mouse.eventFlags & meDoubleClick) && newItem >= 0 && newItem < rowCount) {
+            activateFocused();
+        }
+        clearEvent(event);
+    } else if (event.what == evKeyDown) {
+        int64_t newItem;
+        bool extend = false;
+        bool moveSelection = true;
+        if (multiSelect && event.keyDown.keyCode == kbCtrlA) {
+            typeAheadText.clear();
+            selectAll();
+            clearEvent(event);
+            return;
+        } else if (event.keyDown.charScan.charCode == ' ' && focusedIndex >= 0 && focusedIndex < rowCount) {
+            typeAheadText.clear();
+            if (checkBoxes) {
+                toggleItemChecked(getSelectedIndex());
+                moveSelection = false;
+            } else if (multiSelect) {
+                toggleFocused();
+                moveSelection = false;
+            } else {
+                activateFocused();
+            }
+            newItem = focusedIndex;
+        } else if (
+            event.keyDown.textLength > 0 && static_cast<unsigned char>(event.keyDown.text[0]) > ' ' &&
+            (event.keyDown.controlKeyState & (kbCtrlShift | kbAltShift)) == 0) {
+            if (!typeAhead(event.keyDown.text, event.keyDown.textLength)) {
+                // Nothing to move to, so leave the key for hotkeys and other views.
+                return;
+            }
+            newItem = focusedIndex;
+        } else {
+            switch (ctrlToArrow(event.keyDown.keyCode)) {
+                case kbUp:
+                    newItem = static_cast<int64_t>(focusedIndex) - 1;
+                    break;
+                case kbDown:
+                    newItem = static_cast<int64_t>(focusedIndex) + 1;
+                    break;
+                case kbPgDn:
+                    newItem = static_cast<int64_t>(focusedIndex) + size.y;
+                    break;
+                case kbPgUp:
+                    newItem = static_cast<int64_t>(focusedIndex) - size.y;
+                    break;
+                case kbHome:
+                    newItem = topIndex;
+                    break;
+                case kbEnd:
+                    newItem = static_cast<int64_t>(topIndex) + size.y - 1;
+                    break;
+                case kbCtrlPgDn:
+                    newItem = static_cast<int64_t>(rowCount) - 1;
+                    break;
+                case kbCtrlPgUp:
+                    newItem = 0;
+                    break;
+                default:
+                    return;
+            }
+            typeAheadText.clear();
+            extend = (event.keyDown.controlKeyState & kbShift) != 0;
+        }
+        focusIndexNum(newItem);
+        if (multiSelect && moveSelection && rowCount > 0) {
+            selectToFocus(extend);
+        }
+        drawDirtyRows();
+        clearEvent(event);
+    } else if (event.what == evBroadcast) {
+        if ((options & ofSelectable) != 0 && vScrollBar != nullptr && event.message.infoPtr == vScrollBar) {
+            if (event.message.command == cmScrollBarClicked) {
+                focus();
+            } else if (event.message.command == cmScrollBarChanged) {
+                focusIndexNum(vScrollBar->value);
+                drawDirtyRows();
+            }
+        }
+    }
 }
 
-void ListBox::focusItem(short item) {
+bool ListBox::typeAhead(const char* text, int32_t length) {
+    // Keystrokes that arrive close together extend the prefix; after a pause, typing starts a new one.
+    auto now = std::chrono::steady_clock::now();
+    if (now - typeAheadTime > std::chrono::seconds(1)) {
+        typeAheadText.clear();
+    }
+    typeAheadTime = now;
+    typeAheadText.append(text, length);
+
+    int32_t row = findPrefixRow(typeAheadText.data(), static_cast<int32_t>(typeAheadText.size()));
+    if (row < 0) {
+        // Keep the selection; a longer prefix that matches nothing should not throw away the match so far.
+        typeAheadText.resize(typeAheadText.size() - length);
+        return false;
+    }
+    focusIndex(row);
+    return true;
+}
+
+void ListBox::focusIndex(int32_t index) {
+    // Port of TListViewer::focusItem() for a single column.
     int32_t oldIndex = getSelectedIndex();
-    TListBox::focusItem(item);
-    int32_t newIndex = getSelectedIndex();
-    fireSelectedIndexChangedIfNeeded(oldIndex, newIndex);
+    int32_t oldRow = focusedIndex;
+    focusedIndex = index;
+    if (vScrollBar != nullptr) {
+        vScrollBar->setValue(index);
+    }
+    if (index < topIndex) {
+        topIndex = index;
+    } else if (index >= static_cast<int64_t>(topIndex) + size.y) {
+        topIndex = index - size.y + 1;
+    }
+
+    // Only the rows the focus left and entered look different. If the view scrolled, drawDirtyRows() also moves the
+    // rest.
+    invalidateRow(oldRow);
+    invalidateRow(index);
+    fireSelectedIndexChangedIfNeeded(oldIndex, getSelectedIndex());
+}
+
+void ListBox::focusIndexNum(int64_t index) {
+    // Port of TListViewer::focusItemNum().
+    if (rowCount == 0) {
+        return;
+    }
+    if (index < 0) {
+        index = 0;
+    } else if (index >= rowCount) {
+        index = rowCount - 1;
+    }
+    focusIndex(static_cast<int32_t>(index));
+}
+
+void ListBox::activateFocused() {
+    // TListViewer::selectItem() broadcasts cmListItemSelected; keep that for any listeners in the owner.
+    message(owner, evBroadcast, cmListItemSelected, this);
+    itemActivatedEventHandler();
+}
+
+void ListBox::selectToFocus(bool extend) {
+    // Selects the focused item alone and makes it the anchor or, when extending, selects the rows from the anchor to the
+    // focused row. The anchor may have been filtered out since; then the range starts at the next row shown.
+    int32_t focusedItem = getSelectedIndex();
+    if (focusedItem < 0) {
+        return;
+    }
+    if (!extend || anchorIndex < 0 || anchorIndex >= getItemCount()) {
+        anchorIndex = focusedItem;
+    }
+    int32_t anchorRow = getFiltered() ? std::min(rowFilter.getRowAtOrAfter(anchorIndex), rowCount - 1) : anchorIndex;
+
+    RangeSet rows;
+    addRows(&rows, std::min(anchorRow, focusedIndex), std::max(anchorRow, focusedIndex));
+    if (!(rows == selection)) {
+        // Only visible rows whose state flipped need a repaint.
+        int64_t lastRow = std::min<int64_t>(static_cast<int64_t>(topIndex) + size.y, rowCount);
+        for (int32_t row = topIndex; row < lastRow; row++) {
+            int32_t source = getSourceIndex(row);
+            if (rows.contains(source) != selection.contains(source)) {
+                invalidateRow(row);
+            }
+        }
+        selection = std::move(rows);
+        fireSelectionChangedIfNeeded(true);
+    }
+}
+
+void ListBox::toggleFocused() {
+    int32_t focusedItem = getSelectedIndex();
+    if (focusedItem < 0) {
+        return;
+    }
+    anchorIndex = focusedItem;
+    invalidateRow(focusedIndex);
+    if (selection.contains(focusedItem)) {
+        selection.remove(focusedItem, focusedItem + 1);
+    } else {
+        selection.add(focusedItem, focusedItem + 1);
+    }
+    fireSelectionChangedIfNeeded(true);
+}
+
+void ListBox::toggleItemChecked(int32_t index) {
+    checkedItems.setRange(index, 1, !checkedItems.get(index));
+    invalidateItems(index, 1);
+    fireCheckedItemsChangedIfNeeded(true);
+}
+
+void ListBox::addRows(RangeSet* set, int32_t firstRow, int32_t lastRow) const {
+    // Without a filter the rows are one run of items; with one, consecutive rows may be far apart.
+    if (!getFiltered()) {
+        set->add(firstRow, lastRow + 1);
+        return;
+    }
+    for (int32_t row = firstRow; row <= lastRow; row++) {
+        int32_t source = getSourceIndex(row);
+        set->add(source, source + 1);
+    }
+}
+
+void ListBox::fireSelectionChangedIfNeeded(bool changed) {
+    if (changed) {
+        drawDirtyRows();
+        selectionChangedEventHandler();
+    }
+}
+
+void ListBox::fireCheckedItemsChangedIfNeeded(bool changed) {
+    if (changed) {
+        drawDirtyRows();
+        checkedItemsChanged();
+    }
 }
 
 void ListBox::fireSelectedIndexChangedIfNeeded(int32_t oldIndex, int32_t newIndex) {
@@ -72,247 +515,790 @@ void ListBox::setItemActivatedEventHandler(EventHandlerFunction function, void*
     itemActivatedEventHandler = EventHandler(function, userData);
 }
 
+void ListBox::setSelectionChangedEventHandler(EventHandlerFunction function, void* userData) {
+    selectionChangedEventHandler = EventHandler(function, userData);
+}
+
 int32_t ListBox::getSelectedIndex() const {
-    if (range <= 0) {
+    if (rowCount <= 0 || focusedIndex < 0) {
+        return -1;
+    }
+    return getSourceIndex(focusedIndex);
+}
+
+int32_t ListBox::getSelectedDisplayIndex() const {
+    if (rowCount <= 0) {
         return -1;
     }
-    return static_cast<int32_t>(focused);
+    return focusedIndex;
 }
 
 void ListBox::setSelectedIndex(int32_t index) {
-    if (range <= 0) {
+    if (rowCount <= 0) {
         // No items, can only be -1
         return;
     }
 
-    int32_t oldIndex = getSelectedIndex();
-
+    // TListViewer always has a focused item while there are items, so -1 keeps focus on the first row.
+    int32_t row;
     if (index < 0) {
-        // Clear selection - but TListViewer always has a focused item
-        // We'll set focused to 0 but track "no selection" via -1 semantics
-        // Actually, TListViewer needs focused >= 0, so we keep focus but report -1
-        // For simplicity, we'll just clamp to valid range
-        index = 0;
-    } else if (index >= range) {
-        index = range - 1;
+        row = 0;
+    } else {
+        row = getDisplayIndex(std::min(index, getItemCount() - 1));
+        if (row < 0) {
+            // Filtered out; there is no row to select.
+            return;
+        }
     }
 
-    focused = static_cast<short>(index);
-    if (vScrollBar != nullptr) {
-        vScrollBar->setValue(index);
+    // focusIndex() scrolls the row into view and fires SelectedIndexChanged.
+    focusIndex(row);
+    if (multiSelect) {
+        selectToFocus(false);
     }
-    drawView();
+    drawDirtyRows();
+}
 
-    fireSelectedIndexChangedIfNeeded(oldIndex, index);
+void ListBox::setSelectedDisplayIndex(int32_t row) {
+    if (rowCount <= 0) {
+        return;
+    }
+    focusIndexNum(row < 0 ? 0 : row);
+    drawDirtyRows();
 }
 
 void ListBox::clearSelection() {
-    // TListViewer always has a focused item when range > 0
-    // We can set focused to -1 if range is 0, but otherwise
-    // we need to keep a valid focus. For "clear selection",
-    // we'll just fire the event if transitioning.
-    // Note: After discussion, TListViewer doesn't really support "no selection"
-    // when items exist. We'll keep focus at 0 but could track separately.
-    // For now, clearSelection resets to first item if items exist.
-    if (range > 0) {
+    // In multi-select mode this empties the selection. A single-select list box always has a focused row while it has
+    // rows, so clearing focuses item 0 again.
+    if (multiSelect) {
+        fireSelectionChangedIfNeeded(selection.clear());
+    } else if (rowCount > 0) {
         setSelectedIndex(0);
     }
 }
 
-int32_t ListBox::getItemCount() const {
-    return stringItems ? static_cast<int32_t>(stringItems->getCount()) : 0;
+BOOL ListBox::getMultiSelect() const {
+    return multiSelect;
 }
 
-const char* ListBox::getItemAt(int32_t index) const {
-    if (stringItems && index >= 0 && index < static_cast<int32_t>(stringItems->getCount())) {
-        return static_cast<const char*>(stringItems->at(index));
+void ListBox::setMultiSelect(BOOL value) {
+    if ((value != FALSE) == (multiSelect != FALSE)) {
+        return;
     }
-    return nullptr;
+    // Switching modes carries the selected item over in both directions.
+    multiSelect = value != FALSE ? TRUE : FALSE;
+    if (multiSelect) {
+        selectToFocus(false);
+    } else {
+        selection.clear();
+        anchorIndex = -1;
+    }
+    Application::invalidate(this);
 }
 
-void ListBox::setItemAt(int32_t index, const char* text) {
-    if (stringItems && index >= 0 && index < static_cast<int32_t>(stringItems->getCount())) {
-        stringItems->atFree(index);
-        stringItems->atInsert(index, newStr(text));
-        drawView();
+bool ListBox::isItemSelected(int32_t index) const {
+    return multiSelect ? selection.contains(index) : index >= 0 && index == getSelectedIndex();
+}
+
+void ListBox::setItemsSelected(int32_t index, int32_t count, bool selected) {
+    if (!multiSelect) {
+        return;
     }
+    int32_t end = static_cast<int32_t>(std::min<int64_t>(static_cast<int64_t>(index) + count, getItemCount()));
+    int64_t lastRow = std::min<int64_t>(static_cast<int64_t>(topIndex) + size.y, rowCount);
+    for (int32_t row = topIndex; row < lastRow; row++) {
+        int32_t source = getSourceIndex(row);
+        if (source >= index && source < end) {
+            invalidateRow(row);
+        }
+    }
+    fireSelectionChangedIfNeeded(selected ? selection.add(index, end) : selection.remove(index, end));
 }
 
-void ListBox::addItem(const char* text) {
-    if (stringItems) {
-        stringItems->atInsert(stringItems->getCount(), newStr(text));
-        updateRange();
+void ListBox::selectAll() {
+    // Selecting everything is one range, whatever the number of items; with a filter, only the rows shown count.
+    if (!multiSelect || rowCount == 0) {
+        return;
     }
+    bool changed;
+    if (getFiltered()) {
+        RangeSet rows = selection;
+        addRows(&rows, 0, rowCount - 1);
+        changed = !(rows == selection);
+        selection = std::move(rows);
+    } else {
+        changed = selection.add(0, rowCount);
+    }
+    fireSelectionChangedIfNeeded(changed);
 }
 
-void ListBox::insertItemAt(int32_t index, const char* text) {
-    if (stringItems && index >= 0 && index <= static_cast<int32_t>(stringItems->getCount())) {
-        int32_t oldIndex = getSelectedIndex();
-        stringItems->atInsert(index, newStr(text));
+int32_t ListBox::getSelectedCount() const {
+    if (!multiSelect) {
+        return getSelectedIndex() >= 0 ? 1 : 0;
+    }
+    return static_cast<int32_t>(selection.getCount());
+}
+
+int32_t ListBox::getSelectedRangeCount() const {
+    if (!multiSelect) {
+        return getSelectedIndex() >= 0 ? 1 : 0;
+    }
+    return selection.getRangeCount();
+}
 
-        // Adjust selection if inserting before or at current selection
-        if (oldIndex >= 0 && index <= oldIndex) {
-            focused = static_cast<short>(oldIndex + 1);
-            lastFiredIndex = focused;
+int32_t ListBox::getSelectedRanges(int32_t firstRange, int32_t* ranges, int32_t capacity) const {
+    int32_t written = 0;
+    if (!multiSelect) {
+        int32_t index = getSelectedIndex();
+        if (index >= 0 && firstRange == 0 && capacity > 0) {
+            ranges[0] = index;
+            ranges[1] = 1;
+            written = 1;
         }
+        return written;
+    }
+    for (int32_t i = firstRange; i < selection.getRangeCount() && written < capacity; i++, written++) {
+        const RangeSet::Range& range = selection.getRange(i);
+        ranges[written * 2] = range.start;
+        ranges[written * 2 + 1] = range.end - range.start;
+    }
+    return written;
+}
 
-        updateRange();
+int32_t ListBox::getItemCount() const {
+    if (virtualTextFunction != nullptr) {
+        return virtualCount;
     }
+    return itemStore.getCount();
 }
 
-void ListBox::removeItemAt(int32_t index) {
-    if (stringItems && index >= 0 && index < static_cast<int32_t>(stringItems->getCount())) {
-        int32_t oldIndex = getSelectedIndex();
-        stringItems->atFree(index);
-        int32_t count = static_cast<int32_t>(stringItems->getCount());
-
-        // Adjust selection
-        if (count == 0) {
-            focused = -1;
-            lastFiredIndex = -1;
-            if (oldIndex >= 0) {
-                selectedIndexChangedEventHandler();
-            }
-        } else if (oldIndex == index) {
-            // Selected item was removed
-            if (index >= count) {
-                focused = static_cast<short>(count - 1);
-            }
-            // Else keep same index (now points to next item)
-            lastFiredIndex = focused;
-            selectedIndexChangedEventHandler();
-        } else if (oldIndex > index) {
-            // Selection was after removed item, adjust index
-            focused = static_cast<short>(oldIndex - 1);
+const char* ListBox::getItemAt(int32_t index) const {
+    if (virtualTextFunction == nullptr && index >= 0 && index < itemStore.getCount()) {
+        return itemStore.at(index);
+    }
+    return nullptr;
+}
+
+int32_t ListBox::getItemText(int32_t index, char* buffer, int32_t bufferSize) const {
+    if (virtualTextFunction != nullptr) {
+        if (index < 0 || index >= virtualCount) {
+            return -1;
+        }
+        if (buffer != nullptr && bufferSize > 0) {
+            buffer[0] = '\0';
         }
+        int32_t length = virtualTextFunction(virtualUserData, index, buffer, bufferSize);
+        if (buffer != nullptr && bufferSize > 0) {
+            buffer[bufferSize - 1] = '\0';
+        }
+        return length;
+    }
 
-        updateRange();
+    if (index < 0 || index >= itemStore.getCount()) {
+        return -1;
+    }
+    int32_t length = itemStore.lengthAt(index);
+    if (buffer != nullptr && bufferSize > 0) {
+        int32_t copyLength = std::min(length, bufferSize - 1);
+        memcpy(buffer, itemStore.at(index), copyLength);
+        buffer[copyLength] = '\0';
     }
+    return length;
 }
 
-void ListBox::clearItems() {
-    if (stringItems) {
+void ListBox::setItemAt(int32_t index, const char* text) {
+    if (virtualTextFunction == nullptr && index >= 0 && index < itemStore.getCount() && sortOrder != SortOrder_None) {
+        // The new text may belong elsewhere, so take the item out and insert it where it sorts.
         int32_t oldIndex = getSelectedIndex();
-        while (stringItems->getCount() > 0) {
-            stringItems->atFree(0);
+        int32_t length = static_cast<int32_t>(strlen(text));
+        int32_t position = getSortedPosition(text, length, index);
+        bool selected = selection.contains(index);
+        bool checked = checkBoxes && checkedItems.get(index);
+        itemStore.removeRange(index, 1);
+        if (prefixIndex.isBuilt()) {
+            prefixIndex.removeRange(index, 1);
         }
-        focused = -1;
-        range = 0;
-        if (vScrollBar != nullptr) {
-            vScrollBar->setParams(0, 0, 0, vScrollBar->pgStep, vScrollBar->arStep);
+        rowFilter.removeRange(index, 1);
+        selection.removeGap(index, 1);
+        if (checkBoxes) {
+            checkedItems.removeRange(index, 1);
         }
-        drawView();
-        if (oldIndex >= 0) {
-            lastFiredIndex = -1;
-            selectedIndexChangedEventHandler();
+        itemStore.insert(position, text, length);
+        itemsInserted(position, 1);
+        if (selected) {
+            selection.add(position, position + 1);
+        }
+        if (checked) {
+            checkedItems.setRange(position, 1, true);
+        }
+
+        // The selection follows the item, whether it is the one that moved or one that shifted to make room.
+        int32_t newIndex = oldIndex;
+        if (oldIndex == index) {
+            newIndex = position;
+        } else if (oldIndex >= 0) {
+            newIndex = oldIndex > index ? oldIndex - 1 : oldIndex;
+            newIndex = newIndex >= position ? newIndex + 1 : newIndex;
+        }
+        itemsChanged(newIndex, false);
+    } else if (virtualTextFunction == nullptr && index >= 0 && index < itemStore.getCount()) {
+        int32_t oldIndex = getSelectedIndex();
+        if (prefixIndex.isBuilt()) {
+            prefixIndex.remove(itemStore, index);
+        }
+        int32_t oldRowCount = getDisplayCount();
+        itemStore.set(index, text, static_cast<int32_t>(strlen(text)));
+        if (prefixIndex.isBuilt()) {
+            prefixIndex.add(itemStore, index);
+        }
+        rowFilter.update(itemStore, index);
+
+        // Unless the filter now shows or hides the item, only its own row changed.
+        if (getDisplayCount() == oldRowCount) {
+            invalidateRow(getDisplayIndex(index));
         }
+        itemsChanged(oldIndex, false);
     }
 }
 
-void ListBox::updateRange() {
-    int32_t count = getItemCount();
-    range = static_cast<short>(count);
-
-    // If we had no selection and now have items, select first and fire event
-    if (focused < 0 && count > 0) {
-        focused = 0;
-        lastFiredIndex = 0;
-        selectedIndexChangedEventHandler();
+void ListBox::addItem(const char* text) {
+    if (virtualTextFunction == nullptr) {
+        insertItemAt(itemStore.getCount(), text);
     }
+}
 
-    if (vScrollBar != nullptr) {
-        vScrollBar->setParams(
-            focused >= 0 ? focused : 0, 0, count > 0 ? count - 1 : 0, vScrollBar->pgStep, vScrollBar->arStep);
+void ListBox::insertItemAt(int32_t index, const char* text) {
+    if (virtualTextFunction == nullptr && index >= 0 && index <= itemStore.getCount()) {
+        // A sorted list decides the position itself.
+        int32_t oldIndex = getSelectedIndex();
+        int32_t length = static_cast<int32_t>(strlen(text));
+        if (sortOrder != SortOrder_None) {
+            index = getSortedPosition(text, length, -1);
+        }
+        itemStore.insert(index, text, length);
+        itemsInserted(index, 1);
+
+        // Inserting before or at the selection keeps the same item selected at its new index.
+        itemsChanged(oldIndex >= 0 && index <= oldIndex ? oldIndex + 1 : oldIndex, false);
     }
-    drawView();
 }
 
-}  // namespace tf
+void ListBox::removeItemAt(int32_t index) {
+    removeRange(index, 1);
+}
 
-TF_DEFAULT_CONSTRUCTOR(ListBox)
+void ListBox::clearItems() {
+    if (virtualTextFunction == nullptr) {
+        int32_t oldIndex = getSelectedIndex();
+        bool selectionChanged = selection.clear();
+        int32_t oldCheckedCount = checkedItems.getSetCount();
+        checkedItems.clear();
+        itemStore.clear();
+        prefixIndex.reset();
+        rowFilter.refresh(itemStore);
+        topIndex = 0;
+        itemsChanged(-1, oldIndex >= 0);
+        fireSelectionChangedIfNeeded(selectionChanged);
+        fireCheckedItemsChangedIfNeeded(oldCheckedCount != 0);
+    }
+}
 
-TF_BOILERPLATE_FUNCTIONS(ListBox)
+void ListBox::addItems(const char* const* texts, int32_t count) {
+    if (virtualTextFunction == nullptr && count > 0) {
+        int32_t oldIndex = getSelectedIndex();
+        int32_t firstIndex = itemStore.getCount();
+        appendItems(texts, count);
+        itemsChanged(sortAppendedItems(firstIndex, oldIndex), false);
+    }
+}
 
-TF_EXPORT tf::Error TfListBoxSetSelectedIndexChangedEventHandler(
-    tf::ListBox* self,
-    tf::EventHandlerFunction function,
-    void* userData) {
-    if (self == nullptr || function == nullptr) {
-        return tf::Error_ArgumentNull;
+void ListBox::addItems(const char* data, const int32_t* offsets, int32_t count) {
+    if (virtualTextFunction == nullptr && count > 0) {
+        int32_t oldIndex = getSelectedIndex();
+        int32_t firstIndex = itemStore.getCount();
+        appendItems(data, offsets, count);
+        itemsChanged(sortAppendedItems(firstIndex, oldIndex), false);
     }
-    self->setSelectedIndexChangedEventHandler(function, userData);
-    return tf::Success;
 }
 
-TF_EXPORT tf::Error TfListBoxSetItemActivatedEventHandler(
-    tf::ListBox* self,
-    tf::EventHandlerFunction function,
-    void* userData) {
-    if (self == nullptr || function == nullptr) {
-        return tf::Error_ArgumentNull;
+void ListBox::replaceItems(const char* const* texts, int32_t count) {
+    if (virtualTextFunction == nullptr) {
+        int32_t oldIndex = getSelectedIndex();
+        int32_t oldCheckedCount = checkedItems.getSetCount();
+        beginReplaceItems();
+        appendItems(texts, count);
+        endReplaceItems(oldIndex);
+        fireCheckedItemsChangedIfNeeded(oldCheckedCount != 0);
     }
-    self->setItemActivatedEventHandler(function, userData);
-    return tf::Success;
 }
 
-TF_EXPORT tf::Error TfListBoxGetSelectedIndex(tf::ListBox* self, int32_t* out) {
-    if (self == nullptr || out == nullptr) {
-        return tf::Error_ArgumentNull;
+void ListBox::replaceItems(const char* data, const int32_t* offsets, int32_t count) {
+    if (virtualTextFunction == nullptr) {
+        int32_t oldIndex = getSelectedIndex();
+        int32_t oldCheckedCount = checkedItems.getSetCount();
+        beginReplaceItems();
+        appendItems(data, offsets, count);
+        endReplaceItems(oldIndex);
+        fireCheckedItemsChangedIfNeeded(oldCheckedCount != 0);
     }
-    *out = self->getSelectedIndex();
-    return tf::Success;
 }
 
-TF_EXPORT tf::Error TfListBoxSetSelectedIndex(tf::ListBox* self, int32_t index) {
-    if (self == nullptr) {
-        return tf::Error_ArgumentNull;
+void ListBox::removeRange(int32_t index, int32_t count) {
+    int32_t total = getItemCount();
+    if (virtualTextFunction != nullptr || index < 0 || count <= 0 || index > total - count) {
+        return;
     }
-    int32_t count = self->getItemCount();
-    if (count == 0) {
-        // No items, only -1 is valid
-        if (index != -1) {
-            return tf::Error_InvalidArgument;
-        }
-        return tf::Success;
+
+    int32_t oldIndex = getSelectedIndex();
+    int64_t oldSelectedCount = selection.getCount();
+    int32_t oldCheckedCount = checkedItems.getSetCount();
+    itemStore.removeRange(index, count);
+    if (prefixIndex.isBuilt()) {
+        prefixIndex.removeRange(index, count);
     }
-    if (index < -1 || index >= count) {
-        return tf::Error_InvalidArgument;
+    rowFilter.removeRange(index, count);
+    selection.removeGap(index, count);
+    if (checkBoxes) {
+        checkedItems.removeRange(index, count);
     }
-    self->setSelectedIndex(index);
-    return tf::Success;
+
+    // If the selected item was removed, the item that followed the range takes its place.
+    if (oldIndex >= index && oldIndex < index + count) {
+        itemsChanged(index, true);
+    } else if (oldIndex >= index + count) {
+        itemsChanged(oldIndex - count, false);
+    } else {
+        itemsChanged(oldIndex, false);
+    }
+    fireSelectionChangedIfNeeded(selection.getCount() != oldSelectedCount);
+    fireCheckedItemsChangedIfNeeded(checkedItems.getSetCount() != oldCheckedCount);
 }
 
-TF_EXPORT tf::Error TfListBoxClearSelection(tf::ListBox* self) {
-    if (self == nullptr) {
-        return tf::Error_ArgumentNull;
+int64_t ListBox::getItemsLength(int32_t index, int32_t count) const {
+    int64_t length = 0;
+    for (int32_t i = index; i < index + count; i++) {
+        length += itemStore.lengthAt(i);
     }
-    self->clearSelection();
-    return tf::Success;
+    return length;
 }
 
-TF_EXPORT tf::Error TfListBoxGetItemCount(tf::ListBox* self, int32_t* out) {
-    if (self == nullptr || out == nullptr) {
-        return tf::Error_ArgumentNull;
+void ListBox::copyItems(int32_t index, int32_t count, char* data, int32_t* offsets) const {
+    int32_t offset = 0;
+    for (int32_t i = 0; i < count; i++) {
+        int32_t length = itemStore.lengthAt(index + i);
+        offsets[i] = offset;
+        memcpy(data + offset, itemStore.at(index + i), length);
+        offset += length;
     }
-    *out = self->getItemCount();
-    return tf::Success;
+    offsets[count] = offset;
 }
 
-TF_EXPORT tf::Error TfListBoxGetItemAt(tf::ListBox* self, int32_t index, const char** out) {
-    if (self == nullptr || out == nullptr) {
-        return tf::Error_ArgumentNull;
+bool ListBox::canAddItems(const char* const* texts, int32_t count, bool replace) const {
+    int64_t length = 0;
+    for (int32_t i = 0; i < count; i++) {
+        length += strlen(texts[i]);
     }
-    if (index < 0 || index >= self->getItemCount()) {
+    return replace ? StringArena().canAdd(count, length) : itemStore.canAdd(count, length);
+}
+
+bool ListBox::canAddItems(const int32_t* offsets, int32_t count, bool replace) const {
+    int64_t length = count > 0 ? static_cast<int64_t>(offsets[count]) - offsets[0] : 0;
+    return replace ? StringArena().canAdd(count, length) : itemStore.canAdd(count, length);
+}
+
+int32_t ListBox::findPrefix(const char* prefix, int32_t length) {
+    if (virtualTextFunction != nullptr) {
+        return -1;
+    }
+    // Built on first use, then kept current by the mutators.
+    if (!prefixIndex.isBuilt()) {
+        prefixIndex.build(itemStore);
+    }
+    return prefixIndex.find(itemStore, prefix, length);
+}
+
+int32_t ListBox::findPrefixRow(const char* prefix, int32_t length) {
+    if (virtualTextFunction != nullptr) {
+        return -1;
+    }
+    if (!prefixIndex.isBuilt()) {
+        prefixIndex.build(itemStore);
+    }
+    // The first match in the whole list may be filtered out, so walk the matches in order until one is shown.
+    int32_t row = -1;
+    prefixIndex.find(itemStore, prefix, length, [this, &row](int32_t index) {
+        row = getDisplayIndex(index);
+        return row >= 0;
+    });
+    return row;
+}
+
+int64_t ListBox::getCellsWritten() const {
+    return cellsWritten;
+}
+
+int64_t ListBox::getMemoryUsage() const {
+    return itemStore.getMemoryUsage() + prefixIndex.getMemoryUsage() + rowFilter.getMemoryUsage() +
+        selection.getMemoryUsage() + checkedItems.getMemoryUsage();
+}
+
+void ListBox::appendItems(const char* const* texts, int32_t count) {
+    // Measure once so the arena and the table each grow a single time.
+    int64_t length = 0;
+    for (int32_t i = 0; i < count; i++) {
+        length += strlen(texts[i]);
+    }
+    itemStore.reserve(count, length);
+    int32_t firstIndex = itemStore.getCount();
+    for (int32_t i = 0; i < count; i++) {
+        itemStore.insert(itemStore.getCount(), texts[i], static_cast<int32_t>(strlen(texts[i])));
+    }
+    itemsInserted(firstIndex, count);
+}
+
+void ListBox::appendItems(const char* data, const int32_t* offsets, int32_t count) {
+    itemStore.reserve(count, static_cast<int64_t>(offsets[count]) - offsets[0]);
+    int32_t firstIndex = itemStore.getCount();
+    for (int32_t i = 0; i < count; i++) {
+        itemStore.insert(itemStore.getCount(), data + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    itemsInserted(firstIndex, count);
+}
+
+void ListBox::itemsInserted(int32_t index, int32_t count) {
+    if (prefixIndex.isBuilt()) {
+        prefixIndex.insert(itemStore, index, count);
+    }
+    rowFilter.insert(itemStore, index, count);
+    selection.insertGap(index, count);
+    if (checkBoxes) {
+        checkedItems.insert(index, count);
+    }
+}
+
+void ListBox::beginReplaceItems() {
+    selection.clear();
+    checkedItems.clear();
+    itemStore.clear();
+    prefixIndex.reset();
+    rowFilter.refresh(itemStore);
+    topIndex = 0;
+}
+
+void ListBox::endReplaceItems(int32_t oldIndex) {
+    sortAppendedItems(0, -1);
+
+    // Every row may have changed, so the selected item changed even if its index did not.
+    itemsChanged(-1, oldIndex >= 0);
+}
+
+int32_t ListBox::getSortOrder() const {
+    return sortOrder;
+}
+
+void ListBox::setSortOrder(int32_t order) {
+    SortOrder oldOrder = sortOrder;
+    sortOrder = static_cast<SortOrder>(order);
+    if (sortOrder != SortOrder_None && sortOrder != oldOrder && itemStore.getCount() > 0) {
+        // Turning sorting off keeps the current order; turning it on or changing it sorts everything once.
+        int32_t oldIndex = virtualTextFunction == nullptr ? getSelectedIndex() : -1;
+        int32_t newIndex = sortAppendedItems(0, oldIndex);
+        if (virtualTextFunction == nullptr) {
+            itemsChanged(newIndex, false);
+        }
+    }
+}
+
+int32_t ListBox::getSortedPosition(const char* text, int32_t length, int32_t excludeIndex) const {
+    // Upper bound, so an item equal to existing ones goes after them and equal items keep the order they were added.
+    // `excludeIndex` is skipped, as if it had already been removed.
+    int32_t low = 0;
+    int32_t high = itemStore.getCount() - (excludeIndex >= 0 ? 1 : 0);
+    while (low < high) {
+        int32_t middle = low + (high - low) / 2;
+        int32_t index = excludeIndex >= 0 && middle >= excludeIndex ? middle + 1 : middle;
+        if (compareItems(sortOrder, text, length, itemStore.at(index), itemStore.lengthAt(index)) < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+int32_t ListBox::sortAppendedItems(int32_t firstIndex, int32_t selectedIndex) {
+    // Items before `firstIndex` are already in order. Returns where the item at `selectedIndex` ended up.
+    int32_t count = itemStore.getCount();
+    if (sortOrder == SortOrder_None || firstIndex >= count) {
+        return selectedIndex;
+    }
+
+    std::vector<int32_t> order(count);
+    for (int32_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    auto less = [this](int32_t x, int32_t y) {
+        return compareItems(sortOrder, itemStore.at(x), itemStore.lengthAt(x), itemStore.at(y), itemStore.lengthAt(y)) <
+            0;
+    };
+    std::stable_sort(order.begin() + firstIndex, order.end(), less);
+    std::inplace_merge(order.begin(), order.begin() + firstIndex, order.end(), less);
+    itemStore.reorder(order);
+    selection.reorder(order);
+    if (checkBoxes) {
+        checkedItems.reorder(order);
+    }
+    prefixIndex.reset();
+    rowFilter.refresh(itemStore);
+
+    if (selectedIndex >= 0) {
+        selectedIndex = static_cast<int32_t>(std::find(order.begin(), order.end(), selectedIndex) - order.begin());
+    }
+    return selectedIndex;
+}
+
+BOOL ListBox::getVirtualMode() const {
+    return virtualTextFunction != nullptr ? TRUE : FALSE;
+}
+
+void ListBox::setVirtualSource(ListBoxVirtualTextFunction function, void* userData) {
+    // Rows from the old source have no relation to rows from the new one, so start over at the top.
+    // Stored items are kept, so clearing the source shows them again.
+    int32_t oldIndex = getSelectedIndex();
+    virtualTextFunction = function;
+    virtualUserData = userData;
+    virtualCount = 0;
+    topIndex = 0;
+    bool selectionChanged = selection.clear();
+    int32_t oldCheckedCount = checkedItems.getSetCount();
+    checkedItems.clear();
+    if (checkBoxes) {
+        checkedItems.resize(getItemCount());
+    }
+    itemsChanged(-1, oldIndex >= 0);
+    fireSelectionChangedIfNeeded(selectionChanged);
+    fireCheckedItemsChangedIfNeeded(oldCheckedCount != 0);
+}
+
+void ListBox::setVirtualCount(int32_t count) {
+    if (virtualTextFunction == nullptr) {
+        return;
+    }
+
+    int32_t oldIndex = getSelectedIndex();
+    virtualCount = count;
+    bool selectionChanged = selection.remove(count, INT32_MAX);
+    int32_t oldCheckedCount = checkedItems.getSetCount();
+    if (checkBoxes) {
+        checkedItems.resize(count);
+    }
+    itemsChanged(oldIndex, false);
+    fireSelectionChangedIfNeeded(selectionChanged);
+    fireCheckedItemsChangedIfNeeded(checkedItems.getSetCount() != oldCheckedCount);
+}
+
+const char* ListBox::getFilter() const {
+    return rowFilter.getQuery().c_str();
+}
+
+void ListBox::setFilter(const char* text, int32_t length) {
+    if (virtualTextFunction == nullptr) {
+        int32_t oldIndex = getSelectedIndex();
+        rowFilter.setQuery(itemStore, text, length);
+        itemsChanged(oldIndex, false);
+    }
+}
+
+BOOL ListBox::getFiltered() const {
+    return virtualTextFunction == nullptr && rowFilter.isActive() ? TRUE : FALSE;
+}
+
+int32_t ListBox::getDisplayCount() const {
+    if (getFiltered()) {
+        return rowFilter.getRowCount();
+    }
+    return getItemCount();
+}
+
+int32_t ListBox::getSourceIndex(int32_t row) const {
+    return getFiltered() ? rowFilter.getSourceIndex(row) : row;
+}
+
+int32_t ListBox::getDisplayIndex(int32_t index) const {
+    return getFiltered() ? rowFilter.getRow(index) : index;
+}
+
+void ListBox::itemsChanged(int32_t newIndex, bool selectedItemChanged) {
+    // Called after every change to the items or to the rows shown. `newIndex` is the item, in item space, that should
+    // be selected now; if it is filtered out, the next visible row is selected instead.
+    rowTexts.clear();
+    rowCount = getDisplayCount();
+    if (rowCount == 0) {
+        focusedIndex = -1;
+        topIndex = 0;
+    } else {
+        if (newIndex < 0) {
+            focusedIndex = 0;
+        } else if (getFiltered()) {
+            focusedIndex = std::min(rowFilter.getRowAtOrAfter(newIndex), rowCount - 1);
+        } else {
+            focusedIndex = std::min(newIndex, rowCount - 1);
+        }
+
+        // Keep the view filled and the selection on screen.
+        topIndex = std::min(topIndex, std::max(0, rowCount - size.y));
+        if (focusedIndex < topIndex) {
+            topIndex = focusedIndex;
+        } else if (focusedIndex >= static_cast<int64_t>(topIndex) + size.y) {
+            topIndex = focusedIndex - size.y + 1;
+        }
+    }
+
+    if (vScrollBar != nullptr) {
+        vScrollBar->setParams(
+            focusedIndex >= 0 ? focusedIndex : 0, 0, rowCount > 0 ? rowCount - 1 : 0, vScrollBar->pgStep,
+            vScrollBar->arStep);
+    }
+    drawDirtyRows();
+
+    // Fire once for the whole change: when the selected item was replaced or removed, or when the selection landed
+    // somewhere other than `newIndex` (the list became empty, the first item was auto-selected, or a filter hid it).
+    int32_t selectedIndex = getSelectedIndex();
+    lastFiredIndex = selectedIndex;
+    anchorIndex = selectedIndex;
+    if (selectedItemChanged || selectedIndex != newIndex) {
+        selectedIndexChangedEventHandler();
+    }
+}
+
+}  // namespace tf
+
+TF_DEFAULT_CONSTRUCTOR(ListBox)
+
+TF_BOILERPLATE_FUNCTIONS(ListBox)
+
+TF_EXPORT tf::Error TfListBoxSetSelectedIndexChangedEventHandler(
+    tf::ListBox* self,
+    tf::EventHandlerFunction function,
+    void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setSelectedIndexChangedEventHandler(function, userData);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetItemActivatedEventHandler(
+    tf::ListBox* self,
+    tf::EventHandlerFunction function,
+    void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setItemActivatedEventHandler(function, userData);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetSelectedIndex(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getSelectedIndex();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetSelectedIndex(tf::ListBox* self, int32_t index) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    int32_t count = self->getItemCount();
+    if (count == 0) {
+        // No items, only -1 is valid
+        if (index != -1) {
+            return tf::Error_InvalidArgument;
+        }
+        return tf::Success;
+    }
+    if (index < -1 || index >= count) {
         return tf::Error_InvalidArgument;
     }
-    const char* item = self->getItemAt(index);
-    if (item == nullptr) {
+    self->setSelectedIndex(index);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxClearSelection(tf::ListBox* self) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->clearSelection();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetItemCount(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getItemCount();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetItemAt(tf::ListBox* self, int32_t index, const char** out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || index >= self->getItemCount()) {
         return tf::Error_InvalidArgument;
     }
-    *out = TF_STRDUP(item);
-    if (*out == nullptr) {
+    // Ask for the length first; in virtual mode the text comes from the application's callback.
+    int32_t length = self->getItemText(index, nullptr, 0);
+    if (length < 0) {
+        return tf::Error_InvalidArgument;
+    }
+    char* item = static_cast<char*>(malloc(static_cast<size_t>(length) + 1));
+    if (item == nullptr) {
         return tf::Error_OutOfMemory;
     }
+    self->getItemText(index, item, length + 1);
+    *out = item;
+    return tf::Success;
+}
+
+// Copies items [index, index + count) into `data` back to back, without null terminators, and writes `count + 1`
+// offsets so that item i spans data[offsets[i]] to data[offsets[i + 1]]. `*outLength` receives the number of bytes the
+// range needs. Call first with a null `data` to learn the size; `offsets` may also be null for that call.
+TF_EXPORT tf::Error TfListBoxCopyItems(
+    tf::ListBox* self,
+    int32_t index,
+    int32_t count,
+    char* data,
+    int32_t dataSize,
+    int32_t* offsets,
+    int32_t* outLength) {
+    if (self == nullptr || outLength == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    if (index < 0 || count < 0 || index > self->getItemCount() - count) {
+        return tf::Error_InvalidArgument;
+    }
+    // Offsets are 32-bit, so a single call can export at most INT32_MAX bytes; larger lists are copied in chunks.
+    int64_t length = self->getItemsLength(index, count);
+    if (length > INT32_MAX) {
+        return tf::Error_InvalidArgument;
+    }
+    *outLength = static_cast<int32_t>(length);
+    if (data == nullptr) {
+        return tf::Success;
+    }
+    if (offsets == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (dataSize < length) {
+        return tf::Error_InvalidArgument;
+    }
+    self->copyItems(index, count, data, offsets);
     return tf::Success;
 }
 
@@ -320,9 +1306,15 @@ TF_EXPORT tf::Error TfListBoxSetItemAt(tf::ListBox* self, int32_t index, const c
     if (self == nullptr || text == nullptr) {
         return tf::Error_ArgumentNull;
     }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
     if (index < 0 || index >= self->getItemCount()) {
         return tf::Error_InvalidArgument;
     }
+    if (!self->canAddItems(&text, 1, false)) {
+        return tf::Error_OutOfMemory;
+    }
     self->setItemAt(index, text);
     return tf::Success;
 }
@@ -331,6 +1323,12 @@ TF_EXPORT tf::Error TfListBoxAddItem(tf::ListBox* self, const char* text) {
     if (self == nullptr || text == nullptr) {
         return tf::Error_ArgumentNull;
     }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    if (!self->canAddItems(&text, 1, false)) {
+        return tf::Error_OutOfMemory;
+    }
     self->addItem(text);
     return tf::Success;
 }
@@ -339,9 +1337,15 @@ TF_EXPORT tf::Error TfListBoxInsertItemAt(tf::ListBox* self, int32_t index, cons
     if (self == nullptr || text == nullptr) {
         return tf::Error_ArgumentNull;
     }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
     if (index < 0 || index > self->getItemCount()) {
         return tf::Error_InvalidArgument;
     }
+    if (!self->canAddItems(&text, 1, false)) {
+        return tf::Error_OutOfMemory;
+    }
     self->insertItemAt(index, text);
     return tf::Success;
 }
@@ -350,6 +1354,9 @@ TF_EXPORT tf::Error TfListBoxRemoveItemAt(tf::ListBox* self, int32_t index) {
     if (self == nullptr) {
         return tf::Error_ArgumentNull;
     }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
     if (index < 0 || index >= self->getItemCount()) {
         return tf::Error_InvalidArgument;
     }
@@ -361,6 +1368,368 @@ TF_EXPORT tf::Error TfListBoxClearItems(tf::ListBox* self) {
     if (self == nullptr) {
         return tf::Error_ArgumentNull;
     }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
     self->clearItems();
     return tf::Success;
 }
+
+static tf::Error checkItemArray(const char* const* texts, int32_t count) {
+    if (count < 0) {
+        return tf::Error_InvalidArgument;
+    }
+    if (count > 0 && texts == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        if (texts[i] == nullptr) {
+            return tf::Error_ArgumentNull;
+        }
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxAddItems(tf::ListBox* self, const char* const* texts, int32_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    tf::Error error = checkItemArray(texts, count);
+    if (error != tf::Success) {
+        return error;
+    }
+    if (!self->canAddItems(texts, count, false)) {
+        return tf::Error_OutOfMemory;
+    }
+    self->addItems(texts, count);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxAddItemsPacked(tf::ListBox* self, const char* data, const int32_t* offsets, int32_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    tf::Error error = tf::checkPackedItems(data, offsets, count);
+    if (error != tf::Success) {
+        return error;
+    }
+    if (!self->canAddItems(offsets, count, false)) {
+        return tf::Error_OutOfMemory;
+    }
+    self->addItems(data, offsets, count);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxReplaceItems(tf::ListBox* self, const char* const* texts, int32_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    tf::Error error = checkItemArray(texts, count);
+    if (error != tf::Success) {
+        return error;
+    }
+    if (!self->canAddItems(texts, count, true)) {
+        return tf::Error_OutOfMemory;
+    }
+    self->replaceItems(texts, count);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxReplaceItemsPacked(
+    tf::ListBox* self,
+    const char* data,
+    const int32_t* offsets,
+    int32_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    tf::Error error = tf::checkPackedItems(data, offsets, count);
+    if (error != tf::Success) {
+        return error;
+    }
+    if (!self->canAddItems(offsets, count, true)) {
+        return tf::Error_OutOfMemory;
+    }
+    self->replaceItems(data, offsets, count);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxRemoveRange(tf::ListBox* self, int32_t index, int32_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    if (index < 0 || count < 0 || index > self->getItemCount() - count) {
+        return tf::Error_InvalidArgument;
+    }
+    self->removeRange(index, count);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetSelectionChangedEventHandler(
+    tf::ListBox* self,
+    tf::EventHandlerFunction function,
+    void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setSelectionChangedEventHandler(function, userData);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetMultiSelect(tf::ListBox* self, BOOL* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getMultiSelect();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetMultiSelect(tf::ListBox* self, BOOL value) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setMultiSelect(value);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetItemSelected(tf::ListBox* self, int32_t index, BOOL* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || index >= self->getItemCount()) {
+        return tf::Error_InvalidArgument;
+    }
+    *out = self->isItemSelected(index) ? TRUE : FALSE;
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetItemsSelected(tf::ListBox* self, int32_t index, int32_t count, BOOL selected) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (!self->getMultiSelect() || index < 0 || count < 0 || index > self->getItemCount() - count) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setItemsSelected(index, count, selected != FALSE);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSelectAll(tf::ListBox* self) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (!self->getMultiSelect()) {
+        return tf::Error_InvalidArgument;
+    }
+    self->selectAll();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetSelectedCount(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getSelectedCount();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetSelectedRangeCount(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getSelectedRangeCount();
+    return tf::Success;
+}
+
+// Writes up to `capacity` selected ranges, starting with range `firstRange`, as (index, count) pairs into `ranges`,
+// which holds `capacity * 2` values. Call again with `firstRange` advanced by `*outCount` until it writes fewer than
+// `capacity`.
+TF_EXPORT tf::Error TfListBoxGetSelectedRanges(
+    tf::ListBox* self,
+    int32_t firstRange,
+    int32_t* ranges,
+    int32_t capacity,
+    int32_t* outCount) {
+    if (self == nullptr || outCount == nullptr || (ranges == nullptr && capacity > 0)) {
+        return tf::Error_ArgumentNull;
+    }
+    if (firstRange < 0 || capacity < 0) {
+        return tf::Error_InvalidArgument;
+    }
+    *outCount = self->getSelectedRanges(firstRange, ranges, capacity);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetCellsWritten(tf::ListBox* self, int64_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getCellsWritten();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetSortOrder(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getSortOrder();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetSortOrder(tf::ListBox* self, int32_t value) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (value < tf::SortOrder_None || value > tf::SortOrder_Natural) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setSortOrder(value);
+    return tf::Success;
+}
+
+// Writes the index that `text` would get from TfListBoxAddItem, or from TfListBoxSetItemAt for item `excludeIndex`
+// when it is not -1. Lets the caller keep a mirror of the items in step with a sorted list.
+TF_EXPORT tf::Error TfListBoxGetSortedPosition(tf::ListBox* self, const char* text, int32_t excludeIndex, int32_t* out) {
+    if (self == nullptr || text == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode() || excludeIndex < -1 || excludeIndex >= self->getItemCount()) {
+        return tf::Error_InvalidArgument;
+    }
+    if (self->getSortOrder() == tf::SortOrder_None) {
+        *out = excludeIndex >= 0 ? excludeIndex : self->getItemCount();
+    } else {
+        *out = self->getSortedPosition(text, static_cast<int32_t>(strlen(text)), excludeIndex);
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetFilter(tf::ListBox* self, const char** out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+
+    *out = TF_STRDUP(self->getFilter());
+    if (*out == nullptr) {
+        return tf::Error_OutOfMemory;
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetFilter(tf::ListBox* self, const char* text) {
+    if (self == nullptr || text == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setFilter(text, static_cast<int32_t>(strlen(text)));
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetDisplayCount(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getDisplayCount();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetSelectedDisplayIndex(tf::ListBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getSelectedDisplayIndex();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetSelectedDisplayIndex(tf::ListBox* self, int32_t row) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    int32_t count = self->getDisplayCount();
+    if (row < -1 || row >= count || (count == 0 && row != -1)) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setSelectedDisplayIndex(row);
+    return tf::Success;
+}
+
+// Maps a display row to the index of the item it shows.
+TF_EXPORT tf::Error TfListBoxGetSourceIndex(tf::ListBox* self, int32_t row, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (row < 0 || row >= self->getDisplayCount()) {
+        return tf::Error_InvalidArgument;
+    }
+    *out = self->getSourceIndex(row);
+    return tf::Success;
+}
+
+// Writes the index of the first item, in case-insensitive sorted order, that starts with `prefix`, or -1 if none does.
+TF_EXPORT tf::Error TfListBoxFindPrefix(tf::ListBox* self, const char* prefix, int32_t* out) {
+    if (self == nullptr || prefix == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (self->getVirtualMode()) {
+        return tf::Error_InvalidArgument;
+    }
+    *out = self->findPrefix(prefix, static_cast<int32_t>(strlen(prefix)));
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetMemoryUsage(tf::ListBox* self, int64_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getMemoryUsage();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxGetVirtualMode(tf::ListBox* self, BOOL* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getVirtualMode();
+    return tf::Success;
+}
+
+// Passing a null function leaves virtual mode and shows the stored items again.
+TF_EXPORT tf::Error TfListBoxSetVirtualSource(
+    tf::ListBox* self,
+    tf::ListBoxVirtualTextFunction function,
+    void* userData) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setVirtualSource(function, userData);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfListBoxSetVirtualCount(tf::ListBox* self, int64_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    // Row indices are exposed as int32_t everywhere else (SelectedIndex, GetItemAt).
+    if (!self->getVirtualMode() || count < 0 || count > INT32_MAX) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setVirtualCount(static_cast<int32_t>(count));
+    return tf::Success;
+}
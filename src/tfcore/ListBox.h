@@ -1,51 +1,211 @@
 #pragma once
 
 #include "common.h"
+#include "Bitset.h"
 #include "EventHandler.h"
+#include "ItemComparer.h"
+#include "PrefixIndex.h"
+#include "RangeSet.h"
+#include "RowFilter.h"
+#include "StringArena.h"
 
 #define Uses_TListBox
 #define Uses_TScrollBar
-#define Uses_TStringCollection
+#define Uses_TEvent
 #include <tvision/tv.h>
 
+#include <chrono>
+#include <vector>
+
 namespace tf {
 
+// Supplies the text of row `index` for a virtual-mode ListBox.
+// Writes at most `bufferSize - 1` bytes of UTF-8 plus a null terminator into `buffer` and returns the full length of
+// the text in bytes (excluding the terminator), like snprintf. `buffer` may be null when `bufferSize` is 0.
+typedef int32_t(TF_CDECL* ListBoxVirtualTextFunction)(void* userData, int32_t index, char* buffer, int32_t bufferSize);
+
 class ListBox : public TListBox {
    public:
     ListBox();
     virtual ~ListBox();
 
-    // Override to intercept selection events
-    virtual void selectItem(short item) override;
-    virtual void focusItem(short item) override;
+    // TListViewer keeps `focused`, `topItem` and `range` as `short`, which caps the list at 32767 rows.
+    // We keep our own 32-bit navigation state and replace the drawing and event handling that reads it.
+    virtual void draw() override;
+    virtual void handleEvent(TEvent& event) override;
 
     // Event handlers
     void setSelectedIndexChangedEventHandler(EventHandlerFunction function, void* userData);
     void setItemActivatedEventHandler(EventHandlerFunction function, void* userData);
+    void setSelectionChangedEventHandler(EventHandlerFunction function, void* userData);
 
-    // Selection management
+    // Selection management. Indices are item indices; the *DisplayIndex variants count only the rows the filter shows.
     int32_t getSelectedIndex() const;
     void setSelectedIndex(int32_t index);
+    int32_t getSelectedDisplayIndex() const;
+    void setSelectedDisplayIndex(int32_t row);
     void clearSelection();
 
+    // Multi-select: any set of items can be selected, kept as item index ranges in a RangeSet, and the selected index
+    // above is only the focused item. Shift extends the selection from an anchor item, Ctrl+click and Space toggle an
+    // item, and Ctrl+A selects every displayed row. In single-select mode the selected ranges are just the selected
+    // index.
+    BOOL getMultiSelect() const;
+    void setMultiSelect(BOOL value);
+    bool isItemSelected(int32_t index) const;
+    void setItemsSelected(int32_t index, int32_t count, bool selected);
+    void selectAll();
+    int32_t getSelectedCount() const;
+    int32_t getSelectedRangeCount() const;
+
+    // Writes up to `capacity` (index, count) pairs into `ranges`, starting with range `firstRange`, in ascending order.
+    // Returns the number of pairs written.
+    int32_t getSelectedRanges(int32_t firstRange, int32_t* ranges, int32_t capacity) const;
+
     // Items management
     int32_t getItemCount() const;
     const char* getItemAt(int32_t index) const;
+    int32_t getItemText(int32_t index, char* buffer, int32_t bufferSize) const;
     void setItemAt(int32_t index, const char* text);
     void addItem(const char* text);
     void insertItemAt(int32_t index, const char* text);
     void removeItemAt(int32_t index);
     void clearItems();
 
+    // Bulk items management: one pass over the collection, at most one SelectedIndexChanged and one redraw.
+    // The packed overloads read item i from `data[offsets[i]]` to `data[offsets[i + 1]]`; `offsets` has `count + 1`
+    // entries and the items are not null-terminated.
+    void addItems(const char* const* texts, int32_t count);
+    void addItems(const char* data, const int32_t* offsets, int32_t count);
+    void replaceItems(const char* const* texts, int32_t count);
+    void replaceItems(const char* data, const int32_t* offsets, int32_t count);
+    void removeRange(int32_t index, int32_t count);
+
+    // Bulk export of stored items. copyItems() writes items [index, index + count) back to back without null terminators
+    // and writes `count + 1` offsets in the same layout as the packed overloads; `data` must hold getItemsLength() bytes.
+    int64_t getItemsLength(int32_t index, int32_t count) const;
+    void copyItems(int32_t index, int32_t count, char* data, int32_t* offsets) const;
+
+    // Sorting: one of the SortOrder values. While sorted, addItem(), insertItemAt() and setItemAt() place each item with
+    // a binary search (insertItemAt() ignores its index), and bulk additions are sorted and merged in.
+    int32_t getSortOrder() const;
+    void setSortOrder(int32_t order);
+    int32_t getSortedPosition(const char* text, int32_t length, int32_t excludeIndex) const;
+
+    // Filtering: show only the stored items that contain `text`, ignoring ASCII case; an empty text shows every item.
+    // The items themselves are untouched. Has no effect in virtual mode.
+    const char* getFilter() const;
+    void setFilter(const char* text, int32_t length);
+    BOOL getFiltered() const;
+    int32_t getDisplayCount() const;
+    int32_t getSourceIndex(int32_t row) const;
+    int32_t getDisplayIndex(int32_t index) const;
+
+    // Case-insensitive prefix search over stored items; see PrefixIndex. Returns -1 if nothing matches or in virtual mode.
+    int32_t findPrefix(const char* prefix, int32_t length);
+
+    // The same search for typing while the list box is focused: returns the row of the first match that the filter
+    // shows, or -1.
+    int32_t findPrefixRow(const char* prefix, int32_t length);
+
+    // Whether the items fit in the 32-bit item storage, either added to the current items or replacing them.
+    bool canAddItems(const char* const* texts, int32_t count, bool replace) const;
+    bool canAddItems(const int32_t* offsets, int32_t count, bool replace) const;
+
+    // Bytes allocated for item storage, the prefix index, the filter, the selection and any check boxes, including
+    // unused capacity.
+    int64_t getMemoryUsage() const;
+
+    // Screen cells this list box has written, for measuring how much a change repaints. Moving the focus repaints
+    // only the rows it left and entered, and replacing an item repaints only its row, unless the view scrolls. A
+    // scroll repaints every row but fetches only the text of the rows it brings into view.
+    int64_t getCellsWritten() const;
+
+    // Virtual mode: rows are fetched on demand from a callback instead of being stored in the list.
+    BOOL getVirtualMode() const;
+    void setVirtualSource(ListBoxVirtualTextFunction function, void* userData);
+    void setVirtualCount(int32_t count);
+
+   protected:
+    // Check boxes: when on, each row draws a check box before its text, Space and a click on the box toggle it, and
+    // `checkedItems` holds one bit per item, kept in step with the items like the selection. CheckedListBox turns them
+    // on and adds the API; a plain ListBox never allocates the bits.
+    bool checkBoxes{ false };
+    Bitset checkedItems;
+
+    // Marks the rows of items [index, index + count) that are in view for drawDirtyRows().
+    void invalidateItems(int32_t index, int32_t count);
+    void drawDirtyRows();
+
+    // Repaints and calls checkedItemsChanged() if `changed`.
+    void fireCheckedItemsChangedIfNeeded(bool changed);
+    virtual void checkedItemsChanged() {}
+
    private:
+    void drawLine(short y, bool selected);
+    void invalidateRow(int32_t row);
+    const char* getRowText(short y);
+    bool isRowSelected(int32_t row) const;
+    void focusIndex(int32_t index);
+    void focusIndexNum(int64_t index);
+    void activateFocused();
+    void selectToFocus(bool extend);
+    void toggleFocused();
+    void toggleItemChecked(int32_t index);
+    void addRows(RangeSet* set, int32_t firstRow, int32_t lastRow) const;
+    void fireSelectionChangedIfNeeded(bool changed);
+    bool typeAhead(const char* text, int32_t length);
     void fireSelectedIndexChangedIfNeeded(int32_t oldIndex, int32_t newIndex);
-    void updateRange();
+    void itemsChanged(int32_t newIndex, bool selectedItemChanged);
+    void itemsInserted(int32_t index, int32_t count);
+    int32_t sortAppendedItems(int32_t firstIndex, int32_t selectedIndex);
+    void appendItems(const char* const* texts, int32_t count);
+    void appendItems(const char* data, const int32_t* offsets, int32_t count);
+    void beginReplaceItems();
+    void endReplaceItems(int32_t oldIndex);
 
     TScrollBar* ownedScrollBar;
-    TStringCollection* stringItems;
+    StringArena itemStore;
+    PrefixIndex prefixIndex;
+    RowFilter rowFilter;
+    SortOrder sortOrder{ SortOrder_None };
+    std::string typeAheadText;
+    std::chrono::steady_clock::time_point typeAheadTime;
     EventHandler selectedIndexChangedEventHandler{};
     EventHandler itemActivatedEventHandler{};
+    EventHandler selectionChangedEventHandler{};
     int32_t lastFiredIndex{ -1 };
+
+    // 32-bit replacements for TListViewer::topItem, TListViewer::focused and TListViewer::range. These count display
+    // rows, which are the items themselves unless a filter is set.
+    int32_t topIndex{ 0 };
+    int32_t focusedIndex{ -1 };
+    int32_t rowCount{ 0 };
+
+    // Multi-select state, in item space. The anchor is where a Shift selection starts.
+    BOOL multiSelect{ FALSE };
+    RangeSet selection;
+    int32_t anchorIndex{ -1 };
+
+    // Rows to repaint with drawDirtyRows(). A change that does not invalidate any rows repaints everything.
+    std::vector<int32_t> dirtyRows;
+    bool rowsInvalidated{ false };
+    int64_t cellsWritten{ 0 };
+
+    // The text of each row on screen, starting at display row `rowTextTop` and cut to fit `rowTextWidth`. Repainting
+    // a row for a focus or selection change reuses it, and a small scroll shifts it, so only rows new to the view call
+    // back into a virtual source. Any change to the items or to the view's size clears it.
+    struct RowText {
+        std::string text;
+        bool fetched{ false };
+    };
+    std::vector<RowText> rowTexts;
+    int32_t rowTextTop{ 0 };
+    short rowTextWidth{ 0 };
+
+    ListBoxVirtualTextFunction virtualTextFunction{ nullptr };
+    void* virtualUserData{ nullptr };
+    int32_t virtualCount{ 0 };
 };
 
 template <>
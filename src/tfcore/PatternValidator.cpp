@@ -0,0 +1,528 @@
+#include "PatternValidator.h"
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+
+namespace tf {
+
+// Caps on the size of what a pattern compiles to, so that a pattern like `(a|b){200}.{200}` fails to compile rather
+// than tying up the UI thread.
+static const int32_t maxRepeat = 255;
+static const size_t maxNfaStates = 100000;
+static const size_t maxDfaStates = 10000;
+
+// Parses the pattern into a Thompson NFA, then builds the DFA by subset construction.
+class PatternCompiler {
+   public:
+    explicit PatternCompiler(const char* pattern) : pattern(pattern), length(static_cast<int32_t>(strlen(pattern))) {}
+
+    std::unique_ptr<PatternValidator> compile(std::string* error) {
+        Fragment fragment;
+        if (!parseAlternation(&fragment)) {
+            *error = message;
+            return nullptr;
+        }
+        if (position < length) {
+            *error = describe("unmatched ')'");
+            return nullptr;
+        }
+        std::unique_ptr<PatternValidator> validator(new PatternValidator());
+        if (!buildDfa(fragment, validator.get())) {
+            *error = message;
+            return nullptr;
+        }
+        return validator;
+    }
+
+   private:
+    typedef std::bitset<256> ByteSet;
+
+    struct NfaState {
+        ByteSet bytes;
+        int32_t next{ -1 };
+        std::vector<int32_t> epsilon;
+    };
+
+    // A piece of the NFA with one way in and one way out. Nothing leaves `end` yet.
+    struct Fragment {
+        int32_t start;
+        int32_t end;
+    };
+
+    const char* pattern;
+    int32_t length;
+    int32_t position{ 0 };
+    std::vector<NfaState> states;
+    std::string message;
+
+    std::string describe(const char* problem) const {
+        return std::string("Invalid pattern at position ") + std::to_string(position) + ": " + problem + ".";
+    }
+
+    bool fail(const char* problem) {
+        message = describe(problem);
+        return false;
+    }
+
+    bool atEnd() const { return position >= length; }
+    unsigned char peek() const { return static_cast<unsigned char>(pattern[position]); }
+
+    int32_t newState() {
+        states.emplace_back();
+        return static_cast<int32_t>(states.size()) - 1;
+    }
+
+    Fragment empty() {
+        Fragment fragment{ newState(), newState() };
+        states[fragment.start].epsilon.push_back(fragment.end);
+        return fragment;
+    }
+
+    Fragment bytes(const ByteSet& set) {
+        Fragment fragment{ newState(), newState() };
+        states[fragment.start].bytes = set;
+        states[fragment.start].next = fragment.end;
+        return fragment;
+    }
+
+    Fragment concat(Fragment a, Fragment b) {
+        states[a.end].epsilon.push_back(b.start);
+        return Fragment{ a.start, b.end };
+    }
+
+    Fragment alternate(Fragment a, Fragment b) {
+        Fragment fragment{ newState(), newState() };
+        states[fragment.start].epsilon = { a.start, b.start };
+        states[a.end].epsilon.push_back(fragment.end);
+        states[b.end].epsilon.push_back(fragment.end);
+        return fragment;
+    }
+
+    Fragment optional(Fragment a) {
+        Fragment fragment{ newState(), newState() };
+        states[fragment.start].epsilon = { a.start, fragment.end };
+        states[a.end].epsilon.push_back(fragment.end);
+        return fragment;
+    }
+
+    Fragment star(Fragment a) {
+        Fragment fragment = optional(a);
+        states[a.end].epsilon.push_back(a.start);
+        return fragment;
+    }
+
+    Fragment plus(Fragment a) {
+        int32_t end = newState();
+        states[a.end].epsilon.push_back(a.start);
+        states[a.end].epsilon.push_back(end);
+        return Fragment{ a.start, end };
+    }
+
+    static ByteSet range(unsigned char first, unsigned char last) {
+        ByteSet set;
+        for (int c = first; c <= last; c++) {
+            set.set(c);
+        }
+        return set;
+    }
+
+    // One UTF-8 character: a byte from `ascii`, or any multi-byte sequence when `multibyte` is set.
+    Fragment character(const ByteSet& ascii, bool multibyte) {
+        Fragment fragment = bytes(ascii);
+        if (multibyte) {
+            ByteSet continuation = range(0x80, 0xBF);
+            Fragment two = concat(bytes(range(0xC2, 0xDF)), bytes(continuation));
+            Fragment three = concat(concat(bytes(range(0xE0, 0xEF)), bytes(continuation)), bytes(continuation));
+            Fragment four = concat(bytes(range(0xF0, 0xF4)), bytes(continuation));
+            four = concat(concat(four, bytes(continuation)), bytes(continuation));
+            fragment = alternate(alternate(fragment, two), alternate(three, four));
+        }
+        return fragment;
+    }
+
+    // The ASCII set for `\d`, `\w` or `\s`, with `negated` set for the upper-case forms. Returns false for other
+    // letters.
+    static bool shorthand(unsigned char c, ByteSet* set, bool* negated) {
+        switch (c) {
+            case 'd':
+            case 'D':
+                *set = range('0', '9');
+                break;
+            case 'w':
+            case 'W':
+                *set = range('a', 'z') | range('A', 'Z') | range('0', '9');
+                set->set('_');
+                break;
+            case 's':
+            case 'S':
+                set->reset();
+                set->set(' ');
+                set->set('\t');
+                break;
+            default:
+                return false;
+        }
+        *negated = c >= 'A' && c <= 'Z';
+        return true;
+    }
+
+    bool parseAlternation(Fragment* out) {
+        Fragment fragment;
+        if (!parseConcatenation(&fragment)) {
+            return false;
+        }
+        while (!atEnd() && peek() == '|') {
+            position++;
+            Fragment next;
+            if (!parseConcatenation(&next)) {
+                return false;
+            }
+            fragment = alternate(fragment, next);
+        }
+        *out = fragment;
+        return true;
+    }
+
+    bool parseConcatenation(Fragment* out) {
+        Fragment fragment = empty();
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            Fragment next;
+            if (!parseRepetition(&next)) {
+                return false;
+            }
+            fragment = concat(fragment, next);
+        }
+        *out = fragment;
+        return true;
+    }
+
+    bool parseRepetition(Fragment* out) {
+        // `{n,m}` needs copies of the atom; each one is made by parsing the atom again.
+        int32_t atomStart = position;
+        Fragment atom;
+        if (!parseAtom(&atom)) {
+            return false;
+        }
+        auto copy = [&](Fragment* fragment) {
+            int32_t saved = position;
+            position = atomStart;
+            parseAtom(fragment);
+            position = saved;
+        };
+
+        if (atEnd()) {
+            *out = atom;
+            return true;
+        }
+        switch (peek()) {
+            case '*':
+                position++;
+                *out = star(atom);
+                break;
+            case '+':
+                position++;
+                *out = plus(atom);
+                break;
+            case '?':
+                position++;
+                *out = optional(atom);
+                break;
+            case '{': {
+                position++;
+                int32_t minimum;
+                int32_t maximum;
+                if (!parseCount(&minimum)) {
+                    return false;
+                }
+                maximum = minimum;
+                if (!atEnd() && peek() == ',') {
+                    position++;
+                    maximum = -1;
+                    if (!atEnd() && peek() != '}' && !parseCount(&maximum)) {
+                        return false;
+                    }
+                }
+                if (atEnd() || peek() != '}') {
+                    return fail("expected '}'");
+                }
+                position++;
+                if (maximum != -1 && maximum < minimum) {
+                    return fail("the maximum count is less than the minimum");
+                }
+
+                Fragment fragment = empty();
+                for (int32_t i = 0; i < minimum; i++) {
+                    Fragment next = atom;
+                    if (i > 0) {
+                        copy(&next);
+                    }
+                    fragment = concat(fragment, next);
+                    if (states.size() > maxNfaStates) {
+                        return fail("the pattern is too large");
+                    }
+                }
+                if (maximum == -1) {
+                    Fragment next = atom;
+                    if (minimum > 0) {
+                        copy(&next);
+                    }
+                    fragment = concat(fragment, star(next));
+                } else {
+                    for (int32_t i = minimum; i < maximum; i++) {
+                        Fragment next = atom;
+                        if (i > 0) {
+                            copy(&next);
+                        }
+                        fragment = concat(fragment, optional(next));
+                        if (states.size() > maxNfaStates) {
+                            return fail("the pattern is too large");
+                        }
+                    }
+                }
+                *out = fragment;
+                break;
+            }
+            default:
+                *out = atom;
+                return true;
+        }
+        if (!atEnd() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{')) {
+            return fail("a quantifier cannot follow another quantifier");
+        }
+        return true;
+    }
+
+    bool parseCount(int32_t* out) {
+        if (atEnd() || peek() < '0' || peek() > '9') {
+            return fail("expected a number");
+        }
+        int32_t value = 0;
+        while (!atEnd() && peek() >= '0' && peek() <= '9') {
+            value = value * 10 + (peek() - '0');
+            if (value > maxRepeat) {
+                return fail("the count is too large");
+            }
+            position++;
+        }
+        *out = value;
+        return true;
+    }
+
+    bool parseAtom(Fragment* out) {
+        unsigned char c = peek();
+        switch (c) {
+            case '(':
+                position++;
+                if (!parseAlternation(out)) {
+                    return false;
+                }
+                if (atEnd() || peek() != ')') {
+                    return fail("expected ')'");
+                }
+                position++;
+                return true;
+            case '[':
+                return parseClass(out);
+            case '.':
+                position++;
+                *out = character(range(0, 0x7F), true);
+                return true;
+            case '\\': {
+                position++;
+                if (atEnd()) {
+                    return fail("the pattern ends with '\\'");
+                }
+                ByteSet set;
+                bool negated;
+                if (shorthand(peek(), &set, &negated)) {
+                    position++;
+                    *out = negated ? character(range(0, 0x7F) & ~set, true) : character(set, false);
+                    return true;
+                }
+                break;
+            }
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+                return fail("nothing to repeat");
+            case '^':
+            case '$':
+                return fail("anchors are not supported; the whole text is always matched");
+            default:
+                break;
+        }
+
+        // A literal byte. Characters outside ASCII are their UTF-8 bytes in a row.
+        ByteSet set;
+        set.set(peek());
+        position++;
+        *out = bytes(set);
+        return true;
+    }
+
+    bool parseClass(Fragment* out) {
+        position++;
+        bool negated = !atEnd() && peek() == '^';
+        if (negated) {
+            position++;
+        }
+        ByteSet set;
+        bool first = true;
+        while (!atEnd() && (peek() != ']' || first)) {
+            first = false;
+            unsigned char c = peek();
+            position++;
+            if (c == '\\') {
+                if (atEnd()) {
+                    return fail("the pattern ends with '\\'");
+                }
+                ByteSet shorthandSet;
+                bool shorthandNegated;
+                if (shorthand(peek(), &shorthandSet, &shorthandNegated)) {
+                    position++;
+                    set |= shorthandNegated ? range(0, 0x7F) & ~shorthandSet : shorthandSet;
+                    continue;
+                }
+                c = peek();
+                position++;
+            }
+            if (c >= 0x80) {
+                return fail("character classes can only list ASCII characters");
+            }
+            unsigned char last = c;
+            if (position + 1 < length && peek() == '-' && pattern[position + 1] != ']') {
+                last = static_cast<unsigned char>(pattern[position + 1]);
+                if (last >= 0x80 || last < c) {
+                    return fail("invalid range in character class");
+                }
+                position += 2;
+            }
+            set |= range(c, last);
+        }
+        if (atEnd()) {
+            return fail("expected ']'");
+        }
+        position++;
+        *out = negated ? character(range(0, 0x7F) & ~set, true) : character(set, false);
+        return true;
+    }
+
+    void closure(std::vector<int32_t>* set) const {
+        std::vector<bool> seen(states.size());
+        std::vector<int32_t> stack(set->begin(), set->end());
+        set->clear();
+        while (!stack.empty()) {
+            int32_t state = stack.back();
+            stack.pop_back();
+            if (seen[state]) {
+                continue;
+            }
+            seen[state] = true;
+            set->push_back(state);
+            for (int32_t next : states[state].epsilon) {
+                stack.push_back(next);
+            }
+        }
+        std::sort(set->begin(), set->end());
+    }
+
+    bool buildDfa(Fragment fragment, PatternValidator* validator) {
+        // Split the bytes into classes: two bytes share a class if every byte set in the NFA has both or neither.
+        uint8_t* classes = validator->byteClasses;
+        int32_t classCount = 1;
+        for (const NfaState& state : states) {
+            if (state.next < 0) {
+                continue;
+            }
+            int32_t split[512];
+            std::fill(split, split + 512, -1);
+            int32_t count = 0;
+            for (int c = 0; c < 256; c++) {
+                int32_t key = classes[c] * 2 + (state.bytes.test(c) ? 1 : 0);
+                if (split[key] < 0) {
+                    split[key] = count++;
+                }
+                classes[c] = static_cast<uint8_t>(split[key]);
+            }
+            classCount = count;
+        }
+        std::vector<unsigned char> representatives(classCount);
+        for (int c = 255; c >= 0; c--) {
+            representatives[classes[c]] = static_cast<unsigned char>(c);
+        }
+
+        std::vector<std::vector<int32_t>> sets;
+        std::map<std::vector<int32_t>, uint32_t> ids;
+        auto add = [&](std::vector<int32_t> set) -> uint32_t {
+            auto it = ids.find(set);
+            if (it != ids.end()) {
+                return it->second;
+            }
+            uint32_t id = static_cast<uint32_t>(sets.size());
+            ids.emplace(set, id);
+            sets.push_back(std::move(set));
+            return id;
+        };
+        add(std::vector<int32_t>());
+        std::vector<int32_t> startSet{ fragment.start };
+        closure(&startSet);
+        add(startSet);
+
+        std::vector<uint32_t>& transitions = validator->transitions;
+        for (size_t i = 0; i < sets.size(); i++) {
+            if (sets.size() > maxDfaStates) {
+                message = "The pattern is too complex.";
+                return false;
+            }
+            for (int32_t c = 0; c < classCount; c++) {
+                std::vector<int32_t> next;
+                for (int32_t state : sets[i]) {
+                    if (states[state].next >= 0 && states[state].bytes.test(representatives[c])) {
+                        next.push_back(states[state].next);
+                    }
+                }
+                closure(&next);
+                transitions.push_back(add(std::move(next)));
+            }
+        }
+
+        // A state is live if an accepting state can be reached from it. Walk the transitions backwards from those.
+        size_t count = sets.size();
+        validator->classCount = classCount;
+        validator->accepting.assign(count, 0);
+        validator->live.assign(count, 0);
+        std::vector<std::vector<uint32_t>> predecessors(count);
+        for (size_t i = 0; i < count; i++) {
+            for (int32_t c = 0; c < classCount; c++) {
+                predecessors[transitions[i * classCount + c]].push_back(static_cast<uint32_t>(i));
+            }
+        }
+        std::vector<uint32_t> stack;
+        for (size_t i = 0; i < count; i++) {
+            if (std::binary_search(sets[i].begin(), sets[i].end(), fragment.end)) {
+                validator->accepting[i] = 1;
+                validator->live[i] = 1;
+                stack.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        while (!stack.empty()) {
+            uint32_t state = stack.back();
+            stack.pop_back();
+            for (uint32_t previous : predecessors[state]) {
+                if (!validator->live[previous]) {
+                    validator->live[previous] = 1;
+                    stack.push_back(previous);
+                }
+            }
+        }
+        return true;
+    }
+};
+
+std::unique_ptr<PatternValidator> PatternValidator::compile(const char* pattern, std::string* error) {
+    return PatternCompiler(pattern).compile(error);
+}
+
+}  // namespace tf
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "common.h"
+#include "Validator.h"
+
+#include <memory>
+#include <vector>
+
+namespace tf {
+
+// Accepts text that matches a regular expression in full. The pattern is compiled once, through an NFA, into a DFA
+// over bytes with a table of transitions, so checking a keystroke is one table lookup per byte typed.
+//
+// The syntax is a small subset of the usual one: literal characters; `.` for any character; `\d`, `\w`, `\s` and their
+// negations `\D`, `\W`, `\S`; character classes such as `[a-z_]` and `[^,]`, which list ASCII characters only; groups
+// in parentheses; `|` between alternatives; and the quantifiers `*`, `+`, `?`, `{n}`, `{n,}` and `{n,m}`. A backslash
+// makes any other character literal. Anchors are implied, as the whole text has to match.
+class PatternValidator : public Validator {
+   public:
+    // Returns nullptr and describes the problem in `error` if the pattern is malformed or its DFA would be too large.
+    static std::unique_ptr<PatternValidator> compile(const char* pattern, std::string* error);
+
+    virtual State start() const override { return State{ startState, 0 }; }
+    virtual State step(State state, unsigned char c) const override {
+        return State{ transitions[state.value * classCount + byteClasses[c]], 0 };
+    }
+    virtual bool isLive(State state) const override { return live[state.value] != 0; }
+    virtual bool isComplete(State state) const override { return accepting[state.value] != 0; }
+
+   private:
+    friend class PatternCompiler;
+
+    // Bytes that no part of the pattern tells apart share a class, which keeps the transition table narrow.
+    uint8_t byteClasses[256]{};
+    int32_t classCount{ 1 };
+
+    // Row s, column c: the state after reading a byte of class c in state s. State 0 is dead and loops to itself.
+    std::vector<uint32_t> transitions;
+    std::vector<uint8_t> accepting;
+    std::vector<uint8_t> live;
+    uint32_t startState{ 1 };
+};
+
+}  // namespace tf
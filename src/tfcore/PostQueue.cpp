@@ -0,0 +1,89 @@
+#include "PostQueue.h"
+
+#define Uses_TEventQueue
+#include <tvision/tv.h>
+
+namespace tf {
+
+PostQueue::PostQueue() : head(&stub), tail(&stub) {}
+
+PostQueue::~PostQueue() {
+    // Callbacks still queued at shutdown are dropped.
+    while (Node* node = pop()) {
+        delete node;
+    }
+}
+
+void PostQueue::post(EventHandlerFunction function, void* userData) {
+    auto node = new Node();
+    node->handler = EventHandler(function, userData);
+    push(node);
+
+    if (!signaled.exchange(true, std::memory_order_acq_rel)) {
+        TEventQueue::wakeUp();
+    }
+}
+
+int32_t PostQueue::drain(int32_t maxBatch) {
+    signaled.store(false, std::memory_order_release);
+
+    int32_t count = 0;
+    while (count < maxBatch) {
+        Node* node = pop();
+        if (node == nullptr) {
+            return count;
+        }
+        auto handler = node->handler;
+        delete node;
+        handler();
+        count++;
+    }
+
+    // Leave the rest for the next pass, so a flood of posts can't hold off input and drawing.
+    if (!signaled.exchange(true, std::memory_order_acq_rel)) {
+        TEventQueue::wakeUp();
+    }
+    return count;
+}
+
+void PostQueue::push(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+// Returns null when the queue is empty, and also when a producer has swapped in its node but not yet linked it; that
+// producer wakes the event loop once it has, since drain() cleared `signaled` first.
+PostQueue::Node* PostQueue::pop() {
+    Node* node = tail;
+    Node* next = node->next.load(std::memory_order_acquire);
+
+    if (node == &stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail = next;
+        node = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+        tail = next;
+        return node;
+    }
+
+    if (node != head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    // `node` is the last one. Put the stub behind it so it can be handed out without emptying the list.
+    push(&stub);
+    next = node->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        tail = next;
+        return node;
+    }
+    return nullptr;
+}
+
+}  // namespace tf
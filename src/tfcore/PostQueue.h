@@ -0,0 +1,50 @@
+#pragma once
+
+#include "common.h"
+#include "EventHandler.h"
+
+#include <atomic>
+
+namespace tf {
+
+// Carries callbacks from any thread to the UI thread, which runs them in order of posting.
+//
+// post() never blocks or takes a lock: the queue is an intrusive multi-producer, single-consumer linked list, after
+// Dmitry Vyukov's. A producer swaps its node into `head` with one atomic exchange and then links the previous node to
+// it. The UI thread reads from `tail` in drain(), which the Application calls on each pass of its event loop.
+//
+// Only the first post() after a drain wakes the event queue; the rest see `signaled` already set and return at once.
+// drain() clears `signaled` before it reads, so a callback posted while it runs wakes the loop again.
+class PostQueue {
+   public:
+    PostQueue();
+    ~PostQueue();
+
+    PostQueue(const PostQueue&) = delete;
+    PostQueue& operator=(const PostQueue&) = delete;
+
+    // Any thread. Queues `function` to run on the UI thread with `userData`. Throws std::bad_alloc if out of memory.
+    void post(EventHandlerFunction function, void* userData);
+
+    // UI thread only. Runs queued callbacks, up to `maxBatch` of them, and returns how many ran. If more are left, the
+    // event loop is woken again so they run on the next pass, after pending input.
+    int32_t drain(int32_t maxBatch = 4096);
+
+   private:
+    struct Node {
+        std::atomic<Node*> next{ nullptr };
+        EventHandler handler;
+    };
+
+    void push(Node* node);
+    Node* pop();
+
+    std::atomic<Node*> head;
+    std::atomic<bool> signaled{ false };
+
+    // UI thread only.
+    Node* tail;
+    Node stub;
+};
+
+}  // namespace tf
@@ -0,0 +1,108 @@
+#include "PrefixIndex.h"
+#include "ItemComparer.h"
+
+#include <algorithm>
+
+namespace tf {
+
+int PrefixIndex::compareFolded(const char* a, int32_t aLength, const char* b, int32_t bLength) {
+    return compareItems(SortOrder_IgnoreCase, a, aLength, b, bLength);
+}
+
+void PrefixIndex::build(const StringArena& items) {
+    int32_t count = items.getCount();
+    order.resize(count);
+    for (int32_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&items](int32_t x, int32_t y) {
+        return compareFolded(items.at(x), items.lengthAt(x), items.at(y), items.lengthAt(y)) < 0;
+    });
+    built = true;
+}
+
+void PrefixIndex::reset() {
+    order.clear();
+    order.shrink_to_fit();
+    built = false;
+}
+
+void PrefixIndex::insert(const StringArena& items, int32_t index, int32_t count) {
+    for (int32_t& entry : order) {
+        if (entry >= index) {
+            entry += count;
+        }
+    }
+
+    if (count == 1) {
+        order.insert(lowerBound(items, index), index);
+        return;
+    }
+
+    // Sort the new entries on their own and merge them in, rather than a binary-search insert per item.
+    auto middle = order.insert(order.end(), count, 0);
+    for (int32_t i = 0; i < count; i++) {
+        middle[i] = index + i;
+    }
+    auto less = [&items](int32_t x, int32_t y) {
+        int result = compareFolded(items.at(x), items.lengthAt(x), items.at(y), items.lengthAt(y));
+        return result < 0 || (result == 0 && x < y);
+    };
+    std::sort(middle, order.end(), less);
+    std::inplace_merge(order.begin(), middle, order.end(), less);
+}
+
+void PrefixIndex::removeRange(int32_t index, int32_t count) {
+    auto end = std::remove_if(
+        order.begin(), order.end(), [index, count](int32_t entry) { return entry >= index && entry < index + count; });
+    order.erase(end, order.end());
+    for (int32_t& entry : order) {
+        if (entry >= index + count) {
+            entry -= count;
+        }
+    }
+}
+
+void PrefixIndex::remove(const StringArena& items, int32_t index) {
+    auto it = lowerBound(items, index);
+    if (it != order.end() && *it == index) {
+        order.erase(it);
+    }
+}
+
+void PrefixIndex::add(const StringArena& items, int32_t index) {
+    order.insert(lowerBound(items, index), index);
+}
+
+int32_t PrefixIndex::find(const StringArena& items, const char* prefix, int32_t length) const {
+    return find(items, prefix, length, [](int32_t) { return true; });
+}
+
+int64_t PrefixIndex::getMemoryUsage() const {
+    return static_cast<int64_t>(order.capacity() * sizeof(int32_t));
+}
+
+bool PrefixIndex::hasPrefix(const StringArena& items, int32_t index, const char* prefix, int32_t length) {
+    return items.lengthAt(index) >= length && compareFolded(items.at(index), length, prefix, length) == 0;
+}
+
+std::vector<int32_t>::const_iterator PrefixIndex::seek(const StringArena& items,
+                                                       const char* prefix,
+                                                       int32_t length) const {
+    // Everything that starts with the prefix sorts at or after it, in one run that begins here.
+    return std::lower_bound(order.begin(), order.end(), 0, [&items, prefix, length](int32_t entry, int) {
+        return compareFolded(items.at(entry), items.lengthAt(entry), prefix, length) < 0;
+    });
+}
+
+std::vector<int32_t>::iterator PrefixIndex::lowerBound(const StringArena& items, int32_t index) {
+    // Position of `index` by (folded text, index); the text is whatever the arena holds for it right now.
+    const char* text = items.at(index);
+    int32_t length = items.lengthAt(index);
+    return std::lower_bound(order.begin(), order.end(), index, [&items, text, length](int32_t entry, int32_t value) {
+        int result = compareFolded(items.at(entry), items.lengthAt(entry), text, length);
+        return result < 0 || (result == 0 && entry < value);
+    });
+}
+
+}  // namespace tf
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common.h"
+#include "StringArena.h"
+
+#include <vector>
+
+namespace tf {
+
+// A permutation of the indices of a StringArena, sorted by case-folded text, for O(log n) prefix lookups.
+// Case folding covers ASCII letters; other bytes compare as unsigned values. Items with equal folded text are ordered
+// by index, so a lookup finds the earliest of them.
+//
+// The index does not observe the arena. The owner calls the matching update after (or, for remove(), before) each
+// change to the arena.
+class PrefixIndex {
+   public:
+    // Compares two strings the way the index orders them, like strcmp().
+    static int compareFolded(const char* a, int32_t aLength, const char* b, int32_t bLength);
+
+    bool isBuilt() const { return built; }
+    void build(const StringArena& items);
+    void reset();
+
+    // Call after items [index, index + count) were inserted into the arena.
+    void insert(const StringArena& items, int32_t index, int32_t count);
+
+    // Call after items [index, index + count) were removed from the arena.
+    void removeRange(int32_t index, int32_t count);
+
+    // Call before and after replacing the text of item `index`.
+    void remove(const StringArena& items, int32_t index);
+    void add(const StringArena& items, int32_t index);
+
+    // Of the items whose folded text starts with `prefix`, returns the one that sorts first, or -1 if there are none.
+    int32_t find(const StringArena& items, const char* prefix, int32_t length) const;
+
+    // Like find(), but passes over the items for which `accept(index)` returns false, such as those a filter hides.
+    template <typename Accept>
+    int32_t find(const StringArena& items, const char* prefix, int32_t length, Accept accept) const {
+        for (auto it = seek(items, prefix, length); it != order.end() && hasPrefix(items, *it, prefix, length); ++it) {
+            if (accept(*it)) {
+                return *it;
+            }
+        }
+        return -1;
+    }
+
+    int64_t getMemoryUsage() const;
+
+   private:
+    static bool hasPrefix(const StringArena& items, int32_t index, const char* prefix, int32_t length);
+    std::vector<int32_t>::const_iterator seek(const StringArena& items, const char* prefix, int32_t length) const;
+    std::vector<int32_t>::iterator lowerBound(const StringArena& items, int32_t index);
+
+    std::vector<int32_t> order;
+    bool built{ false };
+};
+
+}  // namespace tf
@@ -1,30 +1,227 @@
 #include "RadioButtonGroup.h"
+#include "Application.h"
 
 #define Uses_TRect
 #define Uses_TRadioButtons
 #define Uses_TSItem
 #define Uses_TStringCollection
+#define Uses_TDrawBuffer
+#define Uses_TEvent
+#define Uses_TKeys
+#define Uses_TGroup
 #include <tvision/tv.h>
 #include <tvision/dialogs.h>
 
+#include <algorithm>
+#include <cctype>
+
 namespace tf {
 
-RadioButtonGroup::RadioButtonGroup() : TRadioButtons(TRect(2, 2, 22, 4), new TSItem("Option 1", nullptr)) {
-    // TCluster constructor creates TStringCollection with delta=0, which cannot grow.
-    // We need to replace it with a growable collection.
-    auto* oldStrings = strings;
-    auto* newStrings = new TStringCollection(10, 10);  // Initial capacity 10, grow by 10
+RadioButtonGroup::RadioButtonGroup() : TRadioButtons(TRect(2, 2, 22, 4), nullptr) {
+    // TCluster::strings stays empty; the items live in itemStore.
+    itemStore.insert(0, "Option 1", 8);
+}
+
+void RadioButtonGroup::draw() {
+    if (size.y <= 0) {
+        return;
+    }
+    for (short y = 0; y < size.y; y++) {
+        drawLine(y);
+    }
+    setCursor(2, focusedIndex - topIndex);
+}
+
+void RadioButtonGroup::drawLine(short y) {
+    // Port of one line of TCluster::drawMultiBox() with TRadioButtons' icon, for a single column that starts at item
+    // `topIndex`. Monochrome markers (showMarkers) are not drawn.
+    static const char* const icon = " ( ) ";
+    static const char* const marker = " \x7";
+    TAttrPair normalColor = getColor(0x0301);
+    TAttrPair selectedColor = getColor(0x0402);
+    TAttrPair disabledColor = getColor(0x0505);
+
+    TDrawBuffer b;
+    b.moveChar(0, ' ', normalColor, size.x);
+    int64_t item = static_cast<int64_t>(topIndex) + y;
+    if (item < getItemCount()) {
+        int32_t index = static_cast<int32_t>(item);
+        TAttrPair color;
+        if ((state & sfDisabled) != 0) {
+            color = disabledColor;
+        } else if (index == focusedIndex && (state & sfSelected) != 0) {
+            color = selectedColor;
+        } else {
+            color = normalColor;
+        }
+        b.moveChar(0, ' ', color, size.x);
+        b.moveCStr(0, icon, color);
+        b.putChar(2, marker[index == selectedIndex ? 1 : 0]);
+        b.moveCStr(5, itemStore.at(index), color);
+    }
+    writeLine(0, y, size.x, 1, b);
+    cellsWritten += size.x;
+}
+
+void RadioButtonGroup::drawItemLines(int32_t firstItem, int32_t lastItem) {
+    // Repaints the lines of items [firstItem, lastItem] that are on screen, and the blank lines below the last item.
+    if (Application::deferDraw(this)) {
+        return;
+    }
+    if (size.y <= 0 || !exposed()) {
+        return;
+    }
+    int64_t first = std::max<int64_t>(firstItem, topIndex);
+    int64_t last = std::min<int64_t>(lastItem, static_cast<int64_t>(topIndex) + size.y - 1);
+    for (int64_t item = first; item <= last; item++) {
+        drawLine(static_cast<short>(item - topIndex));
+    }
+    setCursor(2, focusedIndex - topIndex);
+}
+
+bool RadioButtonGroup::scrollToFocus() {
+    // Keeps the view filled and the focused item on screen. Returns whether the view moved.
+    int32_t oldTopIndex = topIndex;
+    topIndex = std::max(0, std::min(topIndex, getItemCount() - size.y));
+    if (focusedIndex < topIndex) {
+        topIndex = focusedIndex;
+    } else if (size.y > 0 && focusedIndex >= static_cast<int64_t>(topIndex) + size.y) {
+        topIndex = focusedIndex - size.y + 1;
+    }
+    return topIndex != oldTopIndex;
+}
+
+void RadioButtonGroup::focusItem(int32_t item) {
+    int32_t oldFocusedIndex = focusedIndex;
+    focusedIndex = item;
+    if (scrollToFocus()) {
+        Application::invalidate(this);
+    } else {
+        drawItemLines(oldFocusedIndex, oldFocusedIndex);
+        drawItemLines(item, item);
+    }
+}
+
+void RadioButtonGroup::selectItem(int32_t item) {
+    int32_t oldIndex = selectedIndex;
+    selectedIndex = item;
+    if (oldIndex != item) {
+        // Only the lines that lost and got the mark change.
+        drawItemLines(oldIndex, oldIndex);
+        drawItemLines(item, item);
+    }
+    fireEventIfChanged(oldIndex, item);
+}
+
+int32_t RadioButtonGroup::findItem(TPoint mouse) const {
+    if (mouse.x < 0 || mouse.x >= size.x || mouse.y < 0 || mouse.y >= size.y) {
+        return -1;
+    }
+    int64_t item = static_cast<int64_t>(topIndex) + mouse.y;
+    return item < getItemCount() ? static_cast<int32_t>(item) : -1;
+}
+
+int32_t RadioButtonGroup::wrapItem(int32_t item, int32_t step) const {
+    // Like the loops in TCluster::handleEvent(): steps from `item`, wrapping around. TCluster::buttonState() is not
+    // consulted; its enable mask has only 32 bits, and every item of the group is enabled.
+    int32_t count = getItemCount();
+    return item + step < 0 ? count - 1 : item + step >= count ? 0 : item + step;
+}
 
-    // Copy items from old to new collection
-    for (ccIndex i = 0; i < oldStrings->getCount(); i++) {
-        newStrings->atInsert(i, newStr(static_cast<const char*>(oldStrings->at(i))));
+void RadioButtonGroup::handleEvent(TEvent& event) {
+    // Port of TCluster::handleEvent() for a single scrolling column with 32-bit indices.
+    // TCluster::handleEvent() is skipped on purpose; it reads the items from TCluster::strings, which is empty.
+    TView::handleEvent(event);
+    if ((options & ofSelectable) == 0) {
+        return;
     }
 
-    // Replace and cleanup
-    strings = newStrings;
-    destroy(static_cast<TCollection*>(oldStrings));
+    if (event.what == evMouseDown) {
+        int32_t item = findItem(makeLocal(event.mouse.where));
+        if (item != -1) {
+            focusItem(item);
+        }
+        do {
+            if (findItem(makeLocal(event.mouse.where)) == focusedIndex) {
+                showCursor();
+            } else {
+                hideCursor();
+            }
+        } while (mouseEvent(event, evMouseMove));
+        showCursor();
+        if (findItem(makeLocal(event.mouse.where)) == focusedIndex) {
+            press(focusedIndex);
+        }
+        clearEvent(event);
+    } else if (event.what == evKeyDown) {
+        // Up and Down wrap around like TCluster; the keys that page through a long group stop at either end.
+        int32_t count = getItemCount();
+        int32_t item = -1;
+        if ((state & sfFocused) != 0 && count > 0) {
+            switch (ctrlToArrow(event.keyDown.keyCode)) {
+                case kbUp:
+                case kbLeft:
+                    item = wrapItem(focusedIndex, -1);
+                    break;
+                case kbDown:
+                case kbRight:
+                    item = wrapItem(focusedIndex, 1);
+                    break;
+                case kbPgUp:
+                    item = std::max(0, focusedIndex - size.y);
+                    break;
+                case kbPgDn:
+                    item = std::min(count - 1, focusedIndex + size.y);
+                    break;
+                case kbHome:
+                    item = 0;
+                    break;
+                case kbEnd:
+                    item = count - 1;
+                    break;
+            }
+        }
+        if (item >= 0) {
+            focusItem(item);
+            movedTo(item);
+            clearEvent(event);
+        } else if (!handleHotKey(event) && event.keyDown.charScan.charCode == ' ' && (state & sfFocused) != 0) {
+            press(focusedIndex);
+            clearEvent(event);
+        }
+    }
+}
 
-    // value starts at 0 (first item selected)
+bool RadioButtonGroup::handleHotKey(TEvent& event) {
+    // The default branch of TCluster::handleEvent(): Alt+letter anywhere, or the plain letter when focused or when
+    // the key went unhandled (post-process), picks the first item whose ~hot key~ it is.
+    if (event.keyDown.keyCode == 0) {
+        return false;
+    }
+    bool plainLetter = owner->phase == TGroup::phPostProcess || (state & sfFocused) != 0;
+    char letter = static_cast<char>(toupper(static_cast<unsigned char>(event.keyDown.charScan.charCode)));
+    int32_t count = getItemCount();
+    for (int32_t i = 0; i < count; i++) {
+        char c = hotKey(itemStore.at(i));
+        if (getAltCode(c) == event.keyDown.keyCode || (plainLetter && c != 0 && letter == c)) {
+            if (focus()) {
+                focusItem(i);
+                movedTo(i);
+                press(i);
+            }
+            clearEvent(event);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RadioButtonGroup::setState(ushort aState, Boolean enable) {
+    // TCluster::setState() would look for an enabled item in TCluster::strings. Only the focus color changes here.
+    TView::setState(aState, enable);
+    if (aState == sfSelected) {
+        drawItemLines(focusedIndex, focusedIndex);
+    }
 }
 
 void RadioButtonGroup::fireEventIfChanged(int32_t oldIndex, int32_t newIndex) {
@@ -35,15 +232,11 @@ void RadioButtonGroup::fireEventIfChanged(int32_t oldIndex, int32_t newIndex) {
 }
 
 void RadioButtonGroup::press(int32_t item) {
-    int32_t oldIndex = getSelectedIndex();
-    TRadioButtons::press(item);
-    fireEventIfChanged(oldIndex, getSelectedIndex());
+    selectItem(item);
 }
 
 void RadioButtonGroup::movedTo(int32_t item) {
-    int32_t oldIndex = getSelectedIndex();
-    TRadioButtons::movedTo(item);
-    fireEventIfChanged(oldIndex, getSelectedIndex());
+    selectItem(item);
 }
 
 void RadioButtonGroup::setSelectedIndexChangedEventHandler(EventHandlerFunction function, void* userData) {
@@ -51,14 +244,19 @@ void RadioButtonGroup::setSelectedIndexChangedEventHandler(EventHandlerFunction
 }
 
 int32_t RadioButtonGroup::getSelectedIndex() const {
-    return static_cast<int32_t>(value);
+    return selectedIndex;
 }
 
 void RadioButtonGroup::setSelectedIndex(int32_t index) {
-    int32_t oldIndex = getSelectedIndex();
-    value = static_cast<uint32_t>(index);
-    sel = index;
-    drawView();
+    if (focusedIndex != index) {
+        focusItem(index);
+    }
+    int32_t oldIndex = selectedIndex;
+    selectedIndex = index;
+    if (oldIndex != index) {
+        drawItemLines(oldIndex, oldIndex);
+        drawItemLines(index, index);
+    }
     if (oldIndex != index && lastFiredIndex != index) {
         lastFiredIndex = index;
         selectedIndexChangedEventHandler();
@@ -66,85 +264,109 @@ void RadioButtonGroup::setSelectedIndex(int32_t index) {
 }
 
 int32_t RadioButtonGroup::getItemCount() const {
-    return strings ? static_cast<int32_t>(strings->getCount()) : 0;
+    return itemStore.getCount();
 }
 
 const char* RadioButtonGroup::getItemAt(int32_t index) const {
-    if (strings && index >= 0 && index < static_cast<int32_t>(strings->getCount())) {
-        return static_cast<const char*>(strings->at(index));
+    if (index >= 0 && index < itemStore.getCount()) {
+        return itemStore.at(index);
     }
     return nullptr;
 }
 
 void RadioButtonGroup::setItemAt(int32_t index, const char* text) {
-    if (strings && index >= 0 && index < static_cast<int32_t>(strings->getCount())) {
-        strings->atFree(index);
-        strings->atInsert(index, newStr(text));
-        drawView();
+    if (index >= 0 && index < itemStore.getCount()) {
+        itemStore.set(index, text, static_cast<int32_t>(strlen(text)));
+        drawItemLines(index, index);
     }
 }
 
 void RadioButtonGroup::addItem(const char* text) {
-    if (strings) {
-        strings->atInsert(strings->getCount(), newStr(text));
-        drawView();
-    }
+    int32_t index = itemStore.getCount();
+    itemStore.insert(index, text, static_cast<int32_t>(strlen(text)));
+    drawItemLines(index, index);
 }
 
 void RadioButtonGroup::insertItemAt(int32_t index, const char* text) {
-    if (strings && index >= 0 && index <= static_cast<int32_t>(strings->getCount())) {
-        strings->atInsert(index, newStr(text));
-        // Adjust selection if inserting before or at current selection
-        if (index <= static_cast<int32_t>(value)) {
-            value++;
-            sel = static_cast<int32_t>(value);
+    if (index >= 0 && index <= itemStore.getCount()) {
+        itemStore.insert(index, text, static_cast<int32_t>(strlen(text)));
+        // The selection follows its item. Into an empty group, the new item is the selected one.
+        if (itemStore.getCount() > 1) {
+            selectedIndex += index <= selectedIndex ? 1 : 0;
+            focusedIndex += index <= focusedIndex ? 1 : 0;
+        }
+        // The items from `index` on moved down a line.
+        if (scrollToFocus()) {
+            Application::invalidate(this);
+        } else {
+            drawItemLines(index, itemStore.getCount() - 1);
         }
-        drawView();
     }
 }
 
 void RadioButtonGroup::removeItemAt(int32_t index) {
-    if (strings && index >= 0 && index < static_cast<int32_t>(strings->getCount())) {
-        strings->atFree(index);
-        int32_t count = static_cast<int32_t>(strings->getCount());
+    if (index >= 0 && index < itemStore.getCount()) {
+        itemStore.removeRange(index, 1);
+        int32_t count = itemStore.getCount();
+        int32_t oldIndex = selectedIndex;
 
         // Adjust selection
         if (count == 0) {
-            value = 0;
-            sel = 0;
-        } else if (static_cast<int32_t>(value) == index) {
+            selectedIndex = 0;
+        } else if (selectedIndex == index) {
             // Selected item was removed, select previous or first
             if (index >= count) {
-                value = static_cast<uint32_t>(count - 1);
+                selectedIndex = count - 1;
             }
-            sel = static_cast<int32_t>(value);
-            lastFiredIndex = static_cast<int32_t>(value);
-            selectedIndexChangedEventHandler();
-        } else if (static_cast<int32_t>(value) > index) {
+        } else if (selectedIndex > index) {
             // Selection was after removed item, adjust index
-            value--;
-            sel = static_cast<int32_t>(value);
+            selectedIndex--;
         }
-        drawView();
-    }
-}
+        focusedIndex = selectedIndex;
 
-void RadioButtonGroup::clearItems() {
-    if (strings) {
-        int32_t oldIndex = getSelectedIndex();
-        while (strings->getCount() > 0) {
-            strings->atFree(0);
+        // The items after `index` moved up a line and the old last line is now blank. The new selection may be above.
+        if (scrollToFocus()) {
+            Application::invalidate(this);
+        } else {
+            drawItemLines(std::min(index, selectedIndex), count);
         }
-        value = 0;
-        sel = 0;
-        drawView();
-        if (oldIndex != 0) {
-            lastFiredIndex = 0;
+        if (count > 0 && oldIndex == index) {
+            lastFiredIndex = selectedIndex;
             selectedIndexChangedEventHandler();
         }
     }
 }
 
+void RadioButtonGroup::clearItems() {
+    int32_t oldIndex = getSelectedIndex();
+    itemStore.clear();
+    selectedIndex = 0;
+    focusedIndex = 0;
+    topIndex = 0;
+    Application::invalidate(this);
+    if (oldIndex != 0) {
+        lastFiredIndex = 0;
+        selectedIndexChangedEventHandler();
+    }
+}
+
+bool RadioButtonGroup::canAddItems(int64_t count, int64_t length) const {
+    return itemStore.canAdd(count, length);
+}
+
+void RadioButtonGroup::addItems(const char* data, const int32_t* offsets, int32_t count) {
+    itemStore.reserve(count, static_cast<int64_t>(offsets[count]) - offsets[0]);
+    int32_t firstIndex = itemStore.getCount();
+    for (int32_t i = 0; i < count; i++) {
+        itemStore.insert(itemStore.getCount(), data + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    drawItemLines(firstIndex, itemStore.getCount() - 1);
+}
+
+int64_t RadioButtonGroup::getCellsWritten() const {
+    return cellsWritten;
+}
+
 }  // namespace tf
 
 TF_DEFAULT_CONSTRUCTOR(RadioButtonGroup)
@@ -215,6 +437,9 @@ TF_EXPORT tf::Error TfRadioButtonGroupSetItemAt(tf::RadioButtonGroup* self, int3
     if (index < 0 || index >= self->getItemCount()) {
         return tf::Error_InvalidArgument;
     }
+    if (!self->canAddItems(1, strlen(text))) {
+        return tf::Error_OutOfMemory;
+    }
     self->setItemAt(index, text);
     return tf::Success;
 }
@@ -223,6 +448,9 @@ TF_EXPORT tf::Error TfRadioButtonGroupAddItem(tf::RadioButtonGroup* self, const
     if (self == nullptr || text == nullptr) {
         return tf::Error_ArgumentNull;
     }
+    if (!self->canAddItems(1, strlen(text))) {
+        return tf::Error_OutOfMemory;
+    }
     self->addItem(text);
     return tf::Success;
 }
@@ -234,10 +462,35 @@ TF_EXPORT tf::Error TfRadioButtonGroupInsertItemAt(tf::RadioButtonGroup* self, i
     if (index < 0 || index > self->getItemCount()) {
         return tf::Error_InvalidArgument;
     }
+    if (!self->canAddItems(1, strlen(text))) {
+        return tf::Error_OutOfMemory;
+    }
     self->insertItemAt(index, text);
     return tf::Success;
 }
 
+TF_EXPORT tf::Error TfRadioButtonGroupAddItemsPacked(
+    tf::RadioButtonGroup* self,
+    const char* data,
+    const int32_t* offsets,
+    int32_t count) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    tf::Error error = tf::checkPackedItems(data, offsets, count);
+    if (error != tf::Success) {
+        return error;
+    }
+    if (count == 0) {
+        return tf::Success;
+    }
+    if (!self->canAddItems(count, static_cast<int64_t>(offsets[count]) - offsets[0])) {
+        return tf::Error_OutOfMemory;
+    }
+    self->addItems(data, offsets, count);
+    return tf::Success;
+}
+
 TF_EXPORT tf::Error TfRadioButtonGroupRemoveItemAt(tf::RadioButtonGroup* self, int32_t index) {
     if (self == nullptr) {
         return tf::Error_ArgumentNull;
@@ -256,3 +509,11 @@ TF_EXPORT tf::Error TfRadioButtonGroupClearItems(tf::RadioButtonGroup* self) {
     self->clearItems();
     return tf::Success;
 }
+
+TF_EXPORT tf::Error TfRadioButtonGroupGetCellsWritten(tf::RadioButtonGroup* self, int64_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getCellsWritten();
+    return tf::Success;
+}
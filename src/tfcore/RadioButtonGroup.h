@@ -2,18 +2,28 @@
 
 #include "common.h"
 #include "EventHandler.h"
+#include "StringArena.h"
 
 #define Uses_TRadioButtons
 #define Uses_TSItem
 #define Uses_TStringCollection
+#define Uses_TEvent
 #include <tvision/tv.h>
 
 namespace tf {
 
+// TRadioButtons with its items in a StringArena and its selection in 32-bit indices, in place of TCluster::strings,
+// TCluster::value and TCluster::sel. The items form a single column that scrolls to keep the focused item in view,
+// and only the lines on screen are drawn, so a group can hold hundreds of options.
 class RadioButtonGroup : public TRadioButtons {
    public:
     RadioButtonGroup();
 
+    // TRadioButtons::draw() lays out every item in columns. This port draws one line at a time, so a change to one
+    // item repaints only the line it is on.
+    virtual void draw() override;
+    virtual void handleEvent(TEvent& event) override;
+    virtual void setState(ushort aState, Boolean enable) override;
     virtual void press(int32_t item) override;
     virtual void movedTo(int32_t item) override;
 
@@ -32,10 +42,32 @@ class RadioButtonGroup : public TRadioButtons {
     void removeItemAt(int32_t index);
     void clearItems();
 
+    // Bulk loading: appends every item, then repaints once. The selection does not change.
+    bool canAddItems(int64_t count, int64_t length) const;
+    void addItems(const char* data, const int32_t* offsets, int32_t count);
+
+    // Screen cells this cluster has written, for measuring how much a change repaints.
+    int64_t getCellsWritten() const;
+
    private:
     void fireEventIfChanged(int32_t oldIndex, int32_t newIndex);
+    void selectItem(int32_t item);
+    void focusItem(int32_t item);
+    bool scrollToFocus();
+    int32_t findItem(TPoint mouse) const;
+    int32_t wrapItem(int32_t item, int32_t step) const;
+    bool handleHotKey(TEvent& event);
+    void drawLine(short y);
+    void drawItemLines(int32_t firstItem, int32_t lastItem);
     EventHandler selectedIndexChangedEventHandler{};
+    StringArena itemStore;
     int32_t lastFiredIndex{ 0 };
+    int64_t cellsWritten{ 0 };
+
+    // 32-bit replacements for TCluster::value and TCluster::sel, and the first item on screen.
+    int32_t selectedIndex{ 0 };
+    int32_t focusedIndex{ 0 };
+    int32_t topIndex{ 0 };
 };
 
 template <>
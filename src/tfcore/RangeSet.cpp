@@ -0,0 +1,152 @@
+#include "RangeSet.h"
+
+#include <algorithm>
+
+namespace tf {
+
+bool RangeSet::contains(int32_t value) const {
+    int32_t index = findRange(value);
+    return index < getRangeCount() && ranges[index].start <= value;
+}
+
+bool RangeSet::operator==(const RangeSet& other) const {
+    return count == other.count && ranges.size() == other.ranges.size() &&
+        std::equal(ranges.begin(), ranges.end(), other.ranges.begin(), [](const Range& a, const Range& b) {
+               return a.start == b.start && a.end == b.end;
+           });
+}
+
+int32_t RangeSet::findRange(int32_t value) const {
+    auto it = std::upper_bound(
+        ranges.begin(), ranges.end(), value, [](int32_t v, const Range& range) { return v < range.end; });
+    return static_cast<int32_t>(it - ranges.begin());
+}
+
+bool RangeSet::add(int32_t start, int32_t end) {
+    if (start >= end) {
+        return false;
+    }
+
+    // Every range that overlaps or touches [start, end) merges into one.
+    auto first = std::lower_bound(
+        ranges.begin(), ranges.end(), start, [](const Range& range, int32_t v) { return range.end < v; });
+    auto last =
+        std::upper_bound(first, ranges.end(), end, [](int32_t v, const Range& range) { return v < range.start; });
+    int64_t merged = 0;
+    for (auto it = first; it != last; ++it) {
+        merged += it->end - it->start;
+    }
+    if (first != last) {
+        start = std::min(start, first->start);
+        end = std::max(end, (last - 1)->end);
+    }
+
+    // Ranges never touch, so covering the merged ranges without adding anything means one range already held it all.
+    int64_t added = static_cast<int64_t>(end) - start - merged;
+    if (added == 0) {
+        return false;
+    }
+    auto it = ranges.erase(first, last);
+    ranges.insert(it, Range{ start, end });
+    count += added;
+    return true;
+}
+
+bool RangeSet::remove(int32_t start, int32_t end) {
+    if (start >= end) {
+        return false;
+    }
+
+    auto first = ranges.begin() + findRange(start);
+    auto last =
+        std::lower_bound(first, ranges.end(), end, [](const Range& range, int32_t v) { return range.start < v; });
+    if (first == last) {
+        return false;
+    }
+
+    // The first and last overlapping ranges may stick out of [start, end); those parts stay.
+    Range head{ first->start, start };
+    Range tail{ end, (last - 1)->end };
+    for (auto it = first; it != last; ++it) {
+        count -= std::min(it->end, end) - std::max(it->start, start);
+    }
+    auto it = ranges.erase(first, last);
+    if (tail.start < tail.end) {
+        it = ranges.insert(it, tail);
+    }
+    if (head.start < head.end) {
+        ranges.insert(it, head);
+    }
+    return true;
+}
+
+bool RangeSet::clear() {
+    if (ranges.empty()) {
+        return false;
+    }
+    ranges.clear();
+    ranges.shrink_to_fit();
+    count = 0;
+    return true;
+}
+
+void RangeSet::insertGap(int32_t index, int32_t gapCount) {
+    if (gapCount <= 0) {
+        return;
+    }
+    int32_t first = findRange(index);
+    if (first < getRangeCount() && ranges[first].start < index) {
+        // The gap opens inside this range and splits it in two.
+        Range tail{ index, ranges[first].end };
+        ranges[first].end = index;
+        ranges.insert(ranges.begin() + first + 1, tail);
+        first++;
+    }
+    for (auto it = ranges.begin() + first; it != ranges.end(); ++it) {
+        it->start += gapCount;
+        it->end += gapCount;
+    }
+}
+
+void RangeSet::removeGap(int32_t index, int32_t gapCount) {
+    if (gapCount <= 0) {
+        return;
+    }
+    remove(index, index + gapCount);
+    int32_t first = findRange(index);
+    for (auto it = ranges.begin() + first; it != ranges.end(); ++it) {
+        it->start -= gapCount;
+        it->end -= gapCount;
+    }
+
+    // The ranges on either side of the gap now touch if both reached its edges.
+    if (first > 0 && first < getRangeCount() && ranges[first - 1].end == ranges[first].start) {
+        ranges[first - 1].end = ranges[first].end;
+        ranges.erase(ranges.begin() + first);
+    }
+}
+
+void RangeSet::reorder(const std::vector<int32_t>& order) {
+    if (ranges.empty()) {
+        return;
+    }
+    std::vector<Range> reordered;
+    int32_t size = static_cast<int32_t>(order.size());
+    for (int32_t i = 0; i < size; i++) {
+        if (!contains(order[i])) {
+            continue;
+        }
+        if (!reordered.empty() && reordered.back().end == i) {
+            reordered.back().end++;
+        } else {
+            reordered.push_back(Range{ i, i + 1 });
+        }
+    }
+    ranges.swap(reordered);
+}
+
+int64_t RangeSet::getMemoryUsage() const {
+    return static_cast<int64_t>(ranges.capacity() * sizeof(Range));
+}
+
+}  // namespace tf
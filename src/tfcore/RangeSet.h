@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common.h"
+
+#include <vector>
+
+namespace tf {
+
+// A set of non-negative integers stored as sorted, disjoint, non-adjacent half-open ranges [start, end).
+// Memory grows with the number of runs rather than with the values, so a set holding every index of a huge list is a
+// single range. Lookups are binary searches; callers that walk values in ascending order can use findRange() once and
+// then advance through the ranges themselves.
+class RangeSet {
+   public:
+    struct Range {
+        int32_t start;
+        int32_t end;
+    };
+
+    bool isEmpty() const { return ranges.empty(); }
+    int64_t getCount() const { return count; }
+    int32_t getRangeCount() const { return static_cast<int32_t>(ranges.size()); }
+    const Range& getRange(int32_t index) const { return ranges[index]; }
+
+    bool contains(int32_t value) const;
+    bool operator==(const RangeSet& other) const;
+
+    // Returns the index of the first range that ends after `value`, or getRangeCount() if there is none.
+    int32_t findRange(int32_t value) const;
+
+    // These return whether the set changed.
+    bool add(int32_t start, int32_t end);
+    bool remove(int32_t start, int32_t end);
+    bool clear();
+
+    // Renumber the values after [index, index + count) was inserted into or removed from the underlying list. Inserted
+    // values are not in the set; removed values leave it.
+    void insertGap(int32_t index, int32_t count);
+    void removeGap(int32_t index, int32_t count);
+
+    // Renumbers the values after the underlying list was rearranged so that item i is the old item order[i].
+    void reorder(const std::vector<int32_t>& order);
+
+    int64_t getMemoryUsage() const;
+
+   private:
+    std::vector<Range> ranges;
+    int64_t count{ 0 };
+};
+
+}  // namespace tf
@@ -0,0 +1,88 @@
+#include "RangeValidator.h"
+
+namespace tf {
+
+// Whether `magnitude`, or `magnitude` followed by more digits, can be in [low, high]. Appending k digits gives the
+// numbers from magnitude * 10^k to magnitude * 10^k + 10^k - 1, and those ranges only move up as k grows.
+static bool canReach(uint64_t magnitude, uint64_t low, uint64_t high) {
+    if (low > high) {
+        return false;
+    }
+    uint64_t scale = 1;
+    while (true) {
+        if (magnitude != 0 && scale > high / magnitude) {
+            return false;
+        }
+        uint64_t first = magnitude * scale;
+        if (first > high) {
+            return false;
+        }
+        uint64_t last = first > UINT64_MAX - (scale - 1) ? UINT64_MAX : first + (scale - 1);
+        if (last >= low) {
+            return true;
+        }
+        if (scale > UINT64_MAX / 10) {
+            return false;
+        }
+        scale *= 10;
+    }
+}
+
+RangeValidator::RangeValidator(int64_t minimum, int64_t maximum) {
+    // Magnitudes are unsigned so that the magnitude of INT64_MIN fits.
+    if (maximum >= 0) {
+        positiveLow = minimum > 0 ? static_cast<uint64_t>(minimum) : 0;
+        positiveHigh = static_cast<uint64_t>(maximum);
+    } else {
+        positiveLow = 1;
+        positiveHigh = 0;
+    }
+    if (minimum <= 0) {
+        negativeLow = maximum < 0 ? 0 - static_cast<uint64_t>(maximum) : 0;
+        negativeHigh = 0 - static_cast<uint64_t>(minimum);
+    } else {
+        negativeLow = 1;
+        negativeHigh = 0;
+    }
+}
+
+Validator::State RangeValidator::start() const {
+    return State{ 0, 0 };
+}
+
+Validator::State RangeValidator::step(State state, unsigned char c) const {
+    if ((state.flags & Flags_Dead) != 0) {
+        return state;
+    }
+    if (c == '-' && state.flags == 0) {
+        return State{ 0, Flags_Negative };
+    }
+    if (c < '0' || c > '9' || state.value > (UINT64_MAX - 9) / 10) {
+        return State{ 0, Flags_Dead };
+    }
+    return State{ state.value * 10 + (c - '0'), state.flags | Flags_Digits };
+}
+
+bool RangeValidator::isLive(State state) const {
+    if ((state.flags & Flags_Dead) != 0) {
+        return false;
+    }
+    if ((state.flags & Flags_Negative) != 0) {
+        return canReach(state.value, negativeLow, negativeHigh);
+    }
+    // Empty text can still become a negative number.
+    return canReach(state.value, positiveLow, positiveHigh) ||
+           ((state.flags & Flags_Digits) == 0 && negativeLow <= negativeHigh);
+}
+
+bool RangeValidator::isComplete(State state) const {
+    if ((state.flags & Flags_Digits) == 0 || (state.flags & Flags_Dead) != 0) {
+        return false;
+    }
+    if ((state.flags & Flags_Negative) != 0) {
+        return state.value >= negativeLow && state.value <= negativeHigh;
+    }
+    return state.value >= positiveLow && state.value <= positiveHigh;
+}
+
+}  // namespace tf
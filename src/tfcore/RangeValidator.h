@@ -0,0 +1,38 @@
+#pragma once
+
+#include "common.h"
+#include "Validator.h"
+
+namespace tf {
+
+// Accepts a whole number, in decimal with an optional leading '-', between `minimum` and `maximum` inclusive. The
+// state is the number read so far, so checking a keystroke is a multiply and an add; nothing is parsed from a string
+// and nothing is allocated.
+//
+// A prefix is live while some string of more digits could bring it into range. With a range of 20 to 25, "2" is live
+// but "3" is not, since 3 is too small and every number that starts with 3 and has more digits is too big.
+class RangeValidator : public Validator {
+   public:
+    RangeValidator(int64_t minimum, int64_t maximum);
+
+    virtual State start() const override;
+    virtual State step(State state, unsigned char c) const override;
+    virtual bool isLive(State state) const override;
+    virtual bool isComplete(State state) const override;
+
+   private:
+    // `value` is the magnitude of the number read so far.
+    enum Flags : uint32_t {
+        Flags_Negative = 1,
+        Flags_Digits = 2,
+        Flags_Dead = 4,
+    };
+
+    // The magnitudes allowed for positive and for negative numbers, as inclusive ranges; empty when low > high.
+    uint64_t positiveLow;
+    uint64_t positiveHigh;
+    uint64_t negativeLow;
+    uint64_t negativeHigh;
+};
+
+}  // namespace tf
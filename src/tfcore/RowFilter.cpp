@@ -0,0 +1,261 @@
+#include "RowFilter.h"
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define TF_ROW_FILTER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace tf {
+
+static inline char foldCase(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+static inline bool equalsFolded(const char* text, const char* foldedQuery, int32_t length) {
+    for (int32_t i = 0; i < length; i++) {
+        if (foldCase(text[i]) != foldedQuery[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool containsScalar(const char* text, int32_t length, const char* foldedQuery, int32_t queryLength, int32_t start) {
+    for (int32_t i = start; i <= length - queryLength; i++) {
+        if (foldCase(text[i]) == foldedQuery[0] && equalsFolded(text + i + 1, foldedQuery + 1, queryLength - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef TF_ROW_FILTER_X86
+
+// The vector loops below compare the first and last query bytes at every position of a block at once, then check the
+// few candidate positions byte by byte. Bytes are lowercased by moving 'A'..'Z' to the bottom of the signed range
+// with one add, so a single signed compare finds them.
+
+static inline int32_t countTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int32_t>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static inline __m128i foldCase128(__m128i v) {
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(128 - 'A')));
+    __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+    return _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+static bool containsSse2(const char* text, int32_t length, const char* foldedQuery, int32_t queryLength) {
+    const __m128i first = _mm_set1_epi8(foldedQuery[0]);
+    const __m128i last = _mm_set1_epi8(foldedQuery[queryLength - 1]);
+    int32_t i = 0;
+    for (; i + queryLength - 1 + 16 <= length; i += 16) {
+        __m128i blockFirst = foldCase128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+        __m128i blockLast = foldCase128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + queryLength - 1)));
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+        while (mask != 0) {
+            int32_t position = i + countTrailingZeros(mask);
+            if (queryLength <= 2 || equalsFolded(text + position + 1, foldedQuery + 1, queryLength - 2)) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return containsScalar(text, length, foldedQuery, queryLength, i);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TF_TARGET_AVX2
+#endif
+
+TF_TARGET_AVX2 static inline __m256i foldCase256(__m256i v) {
+    __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(128 - 'A')));
+    __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + 26)), shifted);
+    return _mm256_or_si256(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+
+TF_TARGET_AVX2 static bool containsAvx2(const char* text, int32_t length, const char* foldedQuery, int32_t queryLength) {
+    const __m256i first = _mm256_set1_epi8(foldedQuery[0]);
+    const __m256i last = _mm256_set1_epi8(foldedQuery[queryLength - 1]);
+    int32_t i = 0;
+    for (; i + queryLength - 1 + 32 <= length; i += 32) {
+        __m256i blockFirst = foldCase256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i)));
+        __m256i blockLast =
+            foldCase256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + queryLength - 1)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+        while (mask != 0) {
+            int32_t position = i + countTrailingZeros(mask);
+            if (queryLength <= 2 || equalsFolded(text + position + 1, foldedQuery + 1, queryLength - 2)) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+    // Most list items are shorter than one AVX2 block, so finish with SSE2 before going scalar.
+    return containsSse2(text + i, length - i, foldedQuery, queryLength);
+}
+
+static bool hasAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // TF_ROW_FILTER_X86
+
+bool RowFilter::contains(const char* text, int32_t length, const char* foldedQuery, int32_t queryLength) {
+    if (queryLength == 0) {
+        return true;
+    }
+    if (queryLength > length) {
+        return false;
+    }
+#ifdef TF_ROW_FILTER_X86
+    static const bool useAvx2 = hasAvx2();
+    if (useAvx2) {
+        return containsAvx2(text, length, foldedQuery, queryLength);
+    }
+    return containsSse2(text, length, foldedQuery, queryLength);
+#else
+    return containsScalar(text, length, foldedQuery, queryLength, 0);
+#endif
+}
+
+int32_t RowFilter::getRow(int32_t sourceIndex) const {
+    auto it = std::lower_bound(rows.begin(), rows.end(), sourceIndex);
+    if (it == rows.end() || *it != sourceIndex) {
+        return -1;
+    }
+    return static_cast<int32_t>(it - rows.begin());
+}
+
+int32_t RowFilter::getRowAtOrAfter(int32_t sourceIndex) const {
+    return static_cast<int32_t>(std::lower_bound(rows.begin(), rows.end(), sourceIndex) - rows.begin());
+}
+
+void RowFilter::setQuery(const StringArena& items, const char* text, int32_t length) {
+    std::string folded(text, length);
+    for (char& c : folded) {
+        c = foldCase(c);
+    }
+
+    if (length == 0) {
+        reset();
+        return;
+    }
+
+    // Anything that contains the new query also contains the old one when the old one is part of it, as it is when the
+    // user types more characters. Then only the current rows need a look.
+    bool refine = active && folded.find(foldedQuery) != std::string::npos;
+    query.assign(text, length);
+    foldedQuery.swap(folded);
+    active = true;
+    if (refine) {
+        auto end = std::remove_if(rows.begin(), rows.end(), [this, &items](int32_t index) {
+            return !matches(items, index);
+        });
+        rows.erase(end, rows.end());
+    } else {
+        refresh(items);
+    }
+}
+
+void RowFilter::reset() {
+    query.clear();
+    foldedQuery.clear();
+    rows.clear();
+    rows.shrink_to_fit();
+    active = false;
+}
+
+void RowFilter::insert(const StringArena& items, int32_t index, int32_t count) {
+    if (!active) {
+        return;
+    }
+    auto position = std::lower_bound(rows.begin(), rows.end(), index);
+    for (auto it = position; it != rows.end(); ++it) {
+        *it += count;
+    }
+    std::vector<int32_t> inserted;
+    for (int32_t i = index; i < index + count; i++) {
+        if (matches(items, i)) {
+            inserted.push_back(i);
+        }
+    }
+    rows.insert(position, inserted.begin(), inserted.end());
+}
+
+void RowFilter::removeRange(int32_t index, int32_t count) {
+    if (!active) {
+        return;
+    }
+    auto first = std::lower_bound(rows.begin(), rows.end(), index);
+    auto last = std::lower_bound(first, rows.end(), index + count);
+    for (auto it = last; it != rows.end(); ++it) {
+        *it -= count;
+    }
+    rows.erase(first, last);
+}
+
+void RowFilter::update(const StringArena& items, int32_t index) {
+    if (!active) {
+        return;
+    }
+    auto it = std::lower_bound(rows.begin(), rows.end(), index);
+    bool present = it != rows.end() && *it == index;
+    bool match = matches(items, index);
+    if (present && !match) {
+        rows.erase(it);
+    } else if (!present && match) {
+        rows.insert(it, index);
+    }
+}
+
+void RowFilter::refresh(const StringArena& items) {
+    rows.clear();
+    if (!active) {
+        return;
+    }
+    int32_t count = items.getCount();
+    for (int32_t i = 0; i < count; i++) {
+        if (matches(items, i)) {
+            rows.push_back(i);
+        }
+    }
+}
+
+int64_t RowFilter::getMemoryUsage() const {
+    return static_cast<int64_t>(rows.capacity() * sizeof(int32_t));
+}
+
+bool RowFilter::matches(const StringArena& items, int32_t index) const {
+    return contains(
+        items.at(index), items.lengthAt(index), foldedQuery.data(), static_cast<int32_t>(foldedQuery.size()));
+}
+
+}  // namespace tf
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common.h"
+#include "StringArena.h"
+
+#include <string>
+#include <vector>
+
+namespace tf {
+
+// The rows of a StringArena whose text contains a query, ignoring ASCII case. The matching source indices are kept in
+// ascending order, so display row `i` shows source item `getSourceIndex(i)`.
+//
+// Extending the query only rescans the rows that matched the shorter query. Like PrefixIndex, the filter does not
+// observe the arena; the owner calls the matching update after each change to it.
+class RowFilter {
+   public:
+    // Case-insensitive substring test. `foldedQuery` must already be lowercase. Uses SSE2, or AVX2 when the CPU has
+    // it, on x86; other targets use the scalar loop.
+    static bool contains(const char* text, int32_t length, const char* foldedQuery, int32_t queryLength);
+
+    bool isActive() const { return active; }
+    const std::string& getQuery() const { return query; }
+    int32_t getRowCount() const { return static_cast<int32_t>(rows.size()); }
+    int32_t getSourceIndex(int32_t row) const { return rows[row]; }
+
+    // Returns the display row of `sourceIndex`, or -1 if it is filtered out.
+    int32_t getRow(int32_t sourceIndex) const;
+
+    // Returns the first display row whose source index is at least `sourceIndex`, or getRowCount() if none is.
+    int32_t getRowAtOrAfter(int32_t sourceIndex) const;
+
+    // An empty query turns the filter off.
+    void setQuery(const StringArena& items, const char* text, int32_t length);
+    void reset();
+
+    // Call after items [index, index + count) were inserted into the arena.
+    void insert(const StringArena& items, int32_t index, int32_t count);
+
+    // Call after items [index, index + count) were removed from the arena.
+    void removeRange(int32_t index, int32_t count);
+
+    // Call after the text of item `index` was replaced.
+    void update(const StringArena& items, int32_t index);
+
+    // Call after the arena was cleared and refilled.
+    void refresh(const StringArena& items);
+
+    int64_t getMemoryUsage() const;
+
+   private:
+    bool matches(const StringArena& items, int32_t index) const;
+
+    std::string query;
+    std::string foldedQuery;
+    std::vector<int32_t> rows;
+    bool active{ false };
+};
+
+}  // namespace tf
@@ -0,0 +1,103 @@
+#include "StringArena.h"
+#include "TextMetrics.h"
+
+namespace tf {
+
+bool StringArena::canAdd(int64_t count, int64_t length) const {
+    // Garbage is reclaimed before the arena would outgrow 32-bit offsets, so only live text counts.
+    int64_t liveLength = static_cast<int64_t>(bytes.size()) - garbageLength;
+    return static_cast<int64_t>(entries.size()) + count <= INT32_MAX && liveLength + length + count <= UINT32_MAX;
+}
+
+void StringArena::reserve(int32_t count, int64_t length) {
+    entries.reserve(entries.size() + count);
+    bytes.reserve(bytes.size() + static_cast<size_t>(length) + count);
+}
+
+void StringArena::insert(int32_t index, const char* text, int32_t length) {
+    // Measure before appending; `text` may point into the arena, which append() can move.
+    uint32_t width = static_cast<uint32_t>(measureWidth(text, length));
+    Entry entry{ append(text, length), static_cast<uint32_t>(length), width };
+    entries.insert(entries.begin() + index, entry);
+}
+
+void StringArena::set(int32_t index, const char* text, int32_t length) {
+    // Append before retiring the old text; a compaction inside append() still counts it as live.
+    uint32_t width = static_cast<uint32_t>(measureWidth(text, length));
+    uint32_t offset = append(text, length);
+    garbageLength += entries[index].length + 1;
+    entries[index] = Entry{ offset, static_cast<uint32_t>(length), width };
+    compactIfNeeded();
+}
+
+void StringArena::removeRange(int32_t index, int32_t count) {
+    for (int32_t i = index; i < index + count; i++) {
+        garbageLength += entries[i].length + 1;
+    }
+    entries.erase(entries.begin() + index, entries.begin() + index + count);
+    if (entries.empty()) {
+        clear();
+    } else {
+        compactIfNeeded();
+    }
+}
+
+void StringArena::clear() {
+    bytes.clear();
+    entries.clear();
+    garbageLength = 0;
+}
+
+void StringArena::reorder(const std::vector<int32_t>& order) {
+    std::vector<Entry> reordered;
+    reordered.reserve(order.size());
+    for (int32_t index : order) {
+        reordered.push_back(entries[index]);
+    }
+    entries.swap(reordered);
+}
+
+int64_t StringArena::getMemoryUsage() const {
+    return static_cast<int64_t>(bytes.capacity()) + static_cast<int64_t>(entries.capacity() * sizeof(Entry));
+}
+
+uint32_t StringArena::append(const char* text, int32_t length) {
+    // `text` may point into the arena itself (e.g. set(i, at(j))), and growing or compacting the arena moves it.
+    const char* base = bytes.data();
+    if (base != nullptr && text >= base && text < base + bytes.size()) {
+        std::string copy(text, length);
+        return append(copy.data(), length);
+    }
+
+    if (bytes.size() + length + 1 > UINT32_MAX) {
+        // canAdd() guarantees the live text fits, so dropping the garbage makes room.
+        compact();
+    }
+
+    size_t offset = bytes.size();
+    bytes.resize(offset + length + 1);
+    memcpy(bytes.data() + offset, text, length);
+    bytes[offset + length] = '\0';
+    return static_cast<uint32_t>(offset);
+}
+
+void StringArena::compactIfNeeded() {
+    // Compacting costs a copy of the live text, so wait until at least half of the arena is garbage.
+    if (garbageLength >= 4096 && garbageLength * 2 >= static_cast<int64_t>(bytes.size())) {
+        compact();
+    }
+}
+
+void StringArena::compact() {
+    std::vector<char> compacted;
+    compacted.reserve(bytes.size() - garbageLength);
+    for (Entry& entry : entries) {
+        uint32_t offset = static_cast<uint32_t>(compacted.size());
+        compacted.insert(compacted.end(), bytes.begin() + entry.offset, bytes.begin() + entry.offset + entry.length + 1);
+        entry.offset = offset;
+    }
+    bytes.swap(compacted);
+    garbageLength = 0;
+}
+
+}  // namespace tf
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common.h"
+
+#include <vector>
+
+namespace tf {
+
+// A list of strings stored back to back in one growable byte arena, with a table of 32-bit offsets and lengths.
+// Compared to one heap allocation per string (TStringCollection + newStr), this has no per-item allocator overhead
+// and keeps neighboring items close together in memory.
+//
+// Each string is stored null-terminated, so at() can be handed straight to Turbo Vision. Replaced and removed strings
+// leave garbage in the arena; it is reclaimed by compacting once it outweighs the live text. The display width of each
+// string is measured once when it is stored, so drawing can tell whether it fits without walking its UTF-8.
+class StringArena {
+   public:
+    int32_t getCount() const { return static_cast<int32_t>(entries.size()); }
+    const char* at(int32_t index) const { return bytes.data() + entries[index].offset; }
+    int32_t lengthAt(int32_t index) const { return static_cast<int32_t>(entries[index].length); }
+    int32_t widthAt(int32_t index) const { return static_cast<int32_t>(entries[index].width); }
+
+    // Whether `count` more strings totalling `length` bytes fit within the 32-bit offsets.
+    bool canAdd(int64_t count, int64_t length) const;
+
+    void reserve(int32_t count, int64_t length);
+    void insert(int32_t index, const char* text, int32_t length);
+    void set(int32_t index, const char* text, int32_t length);
+    void removeRange(int32_t index, int32_t count);
+    void clear();
+
+    // Rearranges the items so that item i is the old item order[i]. Only the table moves; the text stays put.
+    void reorder(const std::vector<int32_t>& order);
+
+    // Bytes allocated for the arena and the table, including unused capacity.
+    int64_t getMemoryUsage() const;
+
+   private:
+    struct Entry {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t width;
+    };
+
+    uint32_t append(const char* text, int32_t length);
+    void compactIfNeeded();
+    void compact();
+
+    std::vector<char> bytes;
+    std::vector<Entry> entries;
+    int64_t garbageLength{ 0 };
+};
+
+}  // namespace tf
@@ -0,0 +1,155 @@
+#include "SuggestionPipeline.h"
+
+#define Uses_TEventQueue
+#include <tvision/tv.h>
+
+#include <algorithm>
+
+namespace tf {
+
+// Pipelines with a result set for the UI thread. Workers add to it; the UI thread empties it and removes pipelines
+// that are destroyed.
+static std::mutex& readyMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<SuggestionPipeline*>& readyList() {
+    static std::vector<SuggestionPipeline*> list;
+    return list;
+}
+
+SuggestionPipeline::SuggestionPipeline() {}
+
+SuggestionPipeline::~SuggestionPipeline() {
+    stop();
+    std::lock_guard<std::mutex> lock(readyMutex());
+    if (queued) {
+        auto& list = readyList();
+        list.erase(std::find(list.begin(), list.end(), this));
+    }
+}
+
+void SuggestionPipeline::setProvider(SuggestionFunction function, void* userData) {
+    stop();
+    this->function = function;
+    this->userData = userData;
+}
+
+void SuggestionPipeline::setReadyEventHandler(EventHandlerFunction function, void* userData) {
+    readyEventHandler = EventHandler(function, userData);
+}
+
+uint64_t SuggestionPipeline::request(const char* text) {
+    if (function == nullptr) {
+        return 0;
+    }
+    if (!worker.joinable()) {
+        worker = std::thread(&SuggestionPipeline::run, this);
+    }
+    uint64_t requested = ++generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requestGeneration = requested;
+        requestText = text;
+        hasRequest = true;
+    }
+    wake.notify_one();
+    return requested;
+}
+
+bool SuggestionPipeline::take(std::string* data, std::vector<int32_t>* offsets) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasResult || resultGeneration != generation.load()) {
+        return false;
+    }
+    data->swap(resultData);
+    offsets->swap(resultOffsets);
+    hasResult = false;
+    return true;
+}
+
+bool SuggestionPipeline::submit(uint64_t generation, const char* data, const int32_t* offsets, int32_t count) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!isCurrent(generation)) {
+            return false;
+        }
+        resultGeneration = generation;
+        if (count == 0) {
+            resultData.clear();
+            resultOffsets.assign(1, 0);
+        } else {
+            resultData.assign(data, offsets[count]);
+            resultOffsets.assign(offsets, offsets + count + 1);
+        }
+        hasResult = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(readyMutex());
+        if (!queued) {
+            queued = true;
+            readyList().push_back(this);
+        }
+    }
+    // Ends the event loop's wait, so the results are shown on this pass rather than at the next input or timeout.
+    TEventQueue::wakeUp();
+    return true;
+}
+
+bool SuggestionPipeline::isCurrent(uint64_t generation) const {
+    return generation == this->generation.load();
+}
+
+void SuggestionPipeline::deliverReady() {
+    // One at a time, since a handler may destroy other pipelines in the list.
+    while (true) {
+        SuggestionPipeline* pipeline;
+        {
+            std::lock_guard<std::mutex> lock(readyMutex());
+            auto& list = readyList();
+            if (list.empty()) {
+                return;
+            }
+            pipeline = list.back();
+            list.pop_back();
+            pipeline->queued = false;
+        }
+        pipeline->readyEventHandler();
+    }
+}
+
+void SuggestionPipeline::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || hasRequest; });
+        if (stopping) {
+            return;
+        }
+        hasRequest = false;
+        uint64_t requested = requestGeneration;
+        std::string text;
+        text.swap(requestText);
+        lock.unlock();
+        if (isCurrent(requested)) {
+            function(userData, requested, text.c_str());
+        }
+        lock.lock();
+    }
+}
+
+void SuggestionPipeline::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    stopping = false;
+    hasRequest = false;
+}
+
+}  // namespace tf
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "common.h"
+#include "EventHandler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tf {
+
+// Looks up suggestions for `text` and passes them to SuggestionPipeline::submit() with the same generation, from any
+// thread. Called on the pipeline's worker thread, never the UI thread.
+typedef void(TF_CDECL* SuggestionFunction)(void* userData, uint64_t generation, const char* text);
+
+// Runs suggestion queries for a TextBox on a worker thread, so a slow provider never holds up typing.
+//
+// Each request() on the UI thread gets a new generation number. The worker runs only the newest request, skipping any
+// that were overtaken while it was busy, and submit() drops result sets for any generation but the newest. Result sets
+// that survive are announced on the UI thread by deliverReady(), which the Application calls on each pass of its event
+// loop, and take() hands over the newest one whole so it can be shown in a single update.
+class SuggestionPipeline {
+   public:
+    SuggestionPipeline();
+    ~SuggestionPipeline();
+
+    SuggestionPipeline(const SuggestionPipeline&) = delete;
+    SuggestionPipeline& operator=(const SuggestionPipeline&) = delete;
+
+    // UI thread only. Changing the provider waits for a query in progress to finish. Null stops the worker.
+    void setProvider(SuggestionFunction function, void* userData);
+    void setReadyEventHandler(EventHandlerFunction function, void* userData);
+
+    // UI thread only. Queues a query for `text`, replacing any query not yet started, and returns its generation.
+    // Does nothing and returns 0 without a provider.
+    uint64_t request(const char* text);
+
+    // UI thread only. Moves out the result set for the newest generation, packed as ListBox::replaceItems() takes it,
+    // and returns true; returns false if there is none.
+    bool take(std::string* data, std::vector<int32_t>* offsets);
+
+    // Any thread. Keeps the result set if `generation` is the newest, and returns whether it did. `offsets` has
+    // `count + 1` entries, as checkPackedItems() expects, and both pointers may be null when `count` is 0.
+    bool submit(uint64_t generation, const char* data, const int32_t* offsets, int32_t count);
+    bool isCurrent(uint64_t generation) const;
+
+    // UI thread only. Raises the ready event of each pipeline with a result set waiting.
+    static void deliverReady();
+
+   private:
+    void run();
+    void stop();
+
+    SuggestionFunction function{ nullptr };
+    void* userData{ nullptr };
+    EventHandler readyEventHandler{};
+
+    std::atomic<uint64_t> generation{ 0 };
+
+    // Guarded by `mutex`: the request waiting for the worker and the result set waiting for the UI thread.
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread worker;
+    bool stopping{ false };
+    bool hasRequest{ false };
+    uint64_t requestGeneration{ 0 };
+    std::string requestText;
+    bool hasResult{ false };
+    uint64_t resultGeneration{ 0 };
+    std::string resultData;
+    std::vector<int32_t> resultOffsets;
+
+    // Whether this pipeline is in the list deliverReady() works through. Guarded by that list's mutex.
+    bool queued{ false };
+};
+
+}  // namespace tf
@@ -1,27 +1,239 @@
 #include "TextBox.h"
+#include "Application.h"
+#include "ListBox.h"
+#include "PatternValidator.h"
+#include "RangeValidator.h"
+#include "TextMetrics.h"
 
 #define Uses_TRect
-#define Uses_TInputLine
+#define Uses_TView
 #define Uses_TEvent
+#define Uses_TKeys
+#define Uses_TDrawBuffer
+#define Uses_TPalette
+#define Uses_TInputLine  // For cpInputLine
+#define Uses_TClipboard
 #include <tvision/tv.h>
 
 #include <algorithm>
 #include <cstring>
+#include <string>
 
 namespace tf {
 
-TextBox::TextBox() : TInputLine(TRect(0, 0, 20, 1), 256, nullptr, ilMaxBytes), previousText(data ? data : "") {}
+static const char rightArrow = '\x10';
+static const char leftArrow = '\x11';
+
+static inline bool isContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// The longest prefix of `text` that is well-formed UTF-8, is at most `room` bytes and does not end inside a UTF-8
+// sequence. Every edit goes through here, so typing, pasting and setText() all drop malformed bytes and what follows.
+static int32_t fitLength(const char* text, int32_t length, int32_t room) {
+    length = validUtf8Length(text, length);
+    if (length <= room) {
+        return length;
+    }
+    int32_t fit = std::max(0, room);
+    while (fit > 0 && isContinuationByte(text[fit])) {
+        fit--;
+    }
+    return fit;
+}
+
+TextBox::TextBox() : TView(TRect(0, 0, 20, 1)) {
+    // As TInputLine sets up.
+    state |= sfCursorVis;
+    options |= ofSelectable | ofFirstClick;
+}
+
+TPalette& TextBox::getPalette() const {
+    static TPalette palette(cpInputLine, sizeof(cpInputLine) - 1);
+    return palette;
+}
+
+void TextBox::draw() {
+    // Port of TInputLine::draw(). Only the bytes that can be on screen are copied out of the buffer: up to four per
+    // column, with room to spare for combining marks.
+    TAttrPair color = getColor((state & sfFocused) ? 2 : 1);
+    TDrawBuffer b;
+    b.moveChar(0, ' ', color, size.x);
+
+    int32_t columns = std::max(0, size.x - 2);
+    int32_t length = buffer.getLength();
+    int32_t windowLength = std::min(length - firstPos, columns * 8 + 8);
+    std::string window(windowLength, '\0');
+    buffer.copy(firstPos, windowLength, &window[0]);
+    int32_t visible = fitWidth(window.data(), windowLength, columns);
+    int32_t firstColumn = columnOf(firstPos);
+    b.moveStr(1, TStringView(window.data(), visible), color);
+
+    if (firstPos + visible < length) {
+        b.moveChar(size.x - 1, rightArrow, getColor(4), 1);
+    }
+    if ((state & sfSelected) != 0) {
+        if (firstPos > 0) {
+            b.moveChar(0, leftArrow, getColor(4), 1);
+        }
+        int32_t left = std::max(selStart, firstPos);
+        int32_t right = std::min(selEnd, firstPos + visible);
+        if (left < right) {
+            int32_t leftColumn = columnOf(left) - firstColumn;
+            int32_t rightColumn = columnOf(right) - firstColumn;
+            b.moveChar(1 + leftColumn, 0, getColor(3), rightColumn - leftColumn);
+        }
+    }
+    writeLine(0, 0, size.x, size.y, b);
+    setCursor(1 + std::max(0, columnOf(curPos) - firstColumn), 0);
+}
 
 void TextBox::handleEvent(TEvent& event) {
-    // Save state before processing
-    previousText = data;
+    // Port of TInputLine::handleEvent(). Every edit goes through replace(), which says whether the text changed, so
+    // nothing has to be compared after the fact.
+    TView::handleEvent(event);
+    if ((state & sfSelected) == 0) {
+        return;
+    }
 
-    // Let TInputLine process the event
-    TInputLine::handleEvent(event);
+    if (event.what == evMouseDown) {
+        if ((event.mouse.eventFlags & meDoubleClick) != 0) {
+            selectAll(true);
+        } else {
+            // Dragging selects from where the button went down; dragging past either edge scrolls.
+            if ((event.mouse.controlKeyState & kbShift) == 0) {
+                curPos = positionAt(makeLocal(event.mouse.where).x);
+                selStart = selEnd = 0;
+            }
+            do {
+                moveCursor(positionAt(makeLocal(event.mouse.where).x), true);
+                scrollToCursor();
+                drawView();
+            } while (mouseEvent(event, evMouseMove | evMouseAuto));
+        }
+        clearEvent(event);
+        return;
+    }
+    if (event.what != evKeyDown) {
+        return;
+    }
 
-    // Detect text changes
-    if (previousText != data) {
-        textChangedEventHandler();
+    bool extend = (event.keyDown.controlKeyState & kbShift) != 0;
+    bool changed = false;
+    switch (event.keyDown.keyCode) {
+        // The clipboard keys come first; ctrlToArrow() below would turn Ctrl+V and Ctrl+X into movement.
+        case kbCtrlIns:
+        case kbCtrlC:
+            copySelection();
+            break;
+        case kbShiftDel:
+        case kbCtrlX:
+            copySelection();
+            changed = replace(selStart, selEnd - selStart, "", 0, true);
+            break;
+        case kbShiftIns:
+        case kbCtrlV:
+            // The text arrives later as a paste, the same as bracketed paste from the terminal.
+            TClipboard::requestText();
+            break;
+        case kbCtrlY:
+            changed = replace(0, buffer.getLength(), "", 0, true);
+            break;
+        default:
+            switch (ctrlToArrow(event.keyDown.keyCode)) {
+                case kbLeft:
+                    moveCursor(prevChar(curPos), extend);
+                    break;
+                case kbRight:
+                    moveCursor(nextChar(curPos), extend);
+                    break;
+                case kbCtrlLeft:
+                    moveCursor(prevWord(curPos), extend);
+                    break;
+                case kbCtrlRight:
+                    moveCursor(nextWord(curPos), extend);
+                    break;
+                case kbHome:
+                    moveCursor(0, extend);
+                    break;
+                case kbEnd:
+                    moveCursor(buffer.getLength(), extend);
+                    break;
+                case kbBack:
+                    if (selStart != selEnd) {
+                        changed = replace(selStart, selEnd - selStart, "", 0, true);
+                    } else if (curPos > 0) {
+                        int32_t previous = prevChar(curPos);
+                        changed = replace(previous, curPos - previous, "", 0, true);
+                    }
+                    break;
+                case kbDel:
+                    if (selStart != selEnd) {
+                        changed = replace(selStart, selEnd - selStart, "", 0, true);
+                    } else if (curPos < buffer.getLength()) {
+                        changed = replace(curPos, nextChar(curPos) - curPos, "", 0, true);
+                    }
+                    break;
+                case kbIns:
+                    setState(sfCursorIns, (state & sfCursorIns) == 0);
+                    break;
+                case kbUp:
+                case kbDown:
+                    if (history.getCount() == 0) {
+                        return;
+                    }
+                    changed = recallHistory(ctrlToArrow(event.keyDown.keyCode) == kbUp ? 1 : -1);
+                    break;
+                default:
+                    if ((event.keyDown.controlKeyState & kbPaste) != 0) {
+                        // A paste arrives as one key event per character. Gathering them with textEvent() and
+                        // inserting the lot at once costs one redraw and one TextChanged, not one per character.
+                        std::string pasted;
+                        char chunk[4096];
+                        size_t chunkLength;
+                        while (textEvent(event, chunk, chunkLength)) {
+                            pasted.append(chunk, chunkLength);
+                        }
+                        int32_t pastedLength = static_cast<int32_t>(pasted.size());
+                        if (pasteFunction == nullptr || !pasteFunction(pasteUserData, pasted.c_str(), pastedLength)) {
+                            changed = insertText(pasted.data(), pastedLength);
+                        }
+                        break;
+                    }
+                    if (event.keyDown.textLength == 0 || static_cast<unsigned char>(event.keyDown.text[0]) < ' ') {
+                        return;
+                    }
+                    // Typing replaces the selection or, in overwrite mode, the character under the cursor.
+                    if (selStart != selEnd) {
+                        changed = replace(
+                            selStart, selEnd - selStart, event.keyDown.text, event.keyDown.textLength, true);
+                    } else if ((state & sfCursorIns) != 0) {
+                        changed = replace(
+                            curPos, nextChar(curPos) - curPos, event.keyDown.text, event.keyDown.textLength, true);
+                    } else {
+                        changed = replace(curPos, 0, event.keyDown.text, event.keyDown.textLength, true);
+                    }
+                    break;
+            }
+            break;
+    }
+
+    scrollToCursor();
+    drawView();
+    clearEvent(event);
+    if (changed) {
+        textChanged();
+    }
+}
+
+void TextBox::setState(ushort aState, Boolean enable) {
+    // As TInputLine: gaining the focus selects all the text, and losing it drops the selection.
+    TView::setState(aState, enable);
+    if (aState == sfSelected || (aState == sfActive && (state & sfSelected) != 0)) {
+        selectAll(enable);
+    }
+    if (aState == sfSelected && !enable && buffer.getLength() > 0) {
+        history.add(buffer.c_str(), buffer.getLength());
     }
 }
 
@@ -29,46 +241,307 @@ void TextBox::setTextChangedEventHandler(EventHandlerFunction function, void* us
     textChangedEventHandler = EventHandler(function, userData);
 }
 
-const char* TextBox::getText() const {
-    return data ? data : "";
+void TextBox::setPasteEventHandler(TextBoxPasteFunction function, void* userData) {
+    pasteFunction = function;
+    pasteUserData = userData;
+}
+
+void TextBox::textChanged() {
+    editGeneration++;
+    suggestions.request(buffer.c_str());
+    textChangedEventHandler();
+}
+
+uint64_t TextBox::getEditGeneration() const {
+    return editGeneration;
+}
+
+bool TextBox::replace(int32_t start, int32_t length, const char* text, int32_t textLength, bool validate) {
+    int32_t fit = fitLength(text, textLength, maxLength - (buffer.getLength() - length));
+    bool changed = fit != length || !buffer.equals(start, text, fit);
+    if (changed && validator) {
+        // Resume from the state where the edit starts and read the new bytes, then the old bytes after the edit until
+        // the state matches the one cached for that byte. The states from there on are unchanged.
+        int32_t oldLength = buffer.getLength();
+        newValidatorStates.clear();
+        Validator::State state = validatorStates[start];
+        for (int32_t i = 0; i < fit; i++) {
+            state = validator->step(state, static_cast<unsigned char>(text[i]));
+            newValidatorStates.push_back(state);
+        }
+        int32_t position = start + length;
+        bool converged = false;
+        while (position < oldLength) {
+            state = validator->step(state, static_cast<unsigned char>(buffer.at(position)));
+            position++;
+            if (state == validatorStates[position]) {
+                converged = true;
+                break;
+            }
+            newValidatorStates.push_back(state);
+        }
+        if (converged) {
+            state = validatorStates.back();
+        }
+        if (validate && !validator->isLive(state) && validator->isLive(validatorStates.back())) {
+            return false;
+        }
+        int32_t keepFrom = converged ? position : oldLength + 1;
+        validatorStates.erase(validatorStates.begin() + start + 1, validatorStates.begin() + keepFrom);
+        validatorStates.insert(
+            validatorStates.begin() + start + 1, newValidatorStates.begin(), newValidatorStates.end());
+    }
+    if (changed) {
+        buffer.erase(start, length);
+        buffer.insert(start, text, fit);
+        graphemes.update(buffer, start, length, fit);
+    }
+    // Text that ends in front of a combining mark takes the mark over, so the cursor goes after the whole cluster.
+    int32_t end = start + fit;
+    int32_t index = graphemes.findByte(end);
+    curPos = graphemes.getByteOffset(index) == end ? end : graphemes.getByteOffset(index + 1);
+    selStart = selEnd = 0;
+    return changed;
+}
+
+bool TextBox::insertText(const char* text, int32_t length) {
+    // One line only: CR LF and every other control character become a single space each.
+    std::string line;
+    line.reserve(length);
+    for (int32_t i = 0; i < length; i++) {
+        if (text[i] == '\r' && i + 1 < length && text[i + 1] == '\n') {
+            continue;
+        }
+        line.push_back(static_cast<unsigned char>(text[i]) < ' ' ? ' ' : text[i]);
+    }
+    return replace(selStart != selEnd ? selStart : curPos, selEnd - selStart, line.data(),
+        static_cast<int32_t>(line.size()), true);
+}
+
+const char* TextBox::getText() {
+    return buffer.c_str();
 }
 
 void TextBox::setText(const char* text) {
     if (!text)
         text = "";
 
-    // TInputLine data buffer is maxLen+1 bytes
-    int32_t len = std::min(static_cast<int32_t>(strlen(text)), maxLen);
-    strncpy(data, text, len);
-    data[len] = '\0';
+    int32_t textLength = static_cast<int32_t>(strlen(text));
+    bool changed = replace(0, buffer.getLength(), text, textLength, false);
 
     // Reset selection and cursor
-    curPos = len;
-    selStart = selEnd = 0;
     firstPos = 0;
 
-    drawView();
+    Application::invalidate(this);
 
-    // Fire TextChanged if different from previous
-    if (previousText != data) {
-        previousText = data;
-        textChangedEventHandler();
+    if (changed) {
+        textChanged();
     }
 }
 
 int32_t TextBox::getMaxLength() const {
-    return maxLen;
+    return maxLength;
+}
+
+void TextBox::setMaxLength(int32_t value) {
+    maxLength = value;
+    int32_t length = buffer.getLength();
+    if (length <= value) {
+        return;
+    }
+
+    // Cut at a cluster boundary, which may leave the text a little shorter than the limit.
+    int32_t cut = graphemes.getByteOffset(graphemes.findByte(value));
+    buffer.erase(cut, length - cut);
+    graphemes.update(buffer, cut, length - cut, 0);
+    if (validator) {
+        validatorStates.resize(cut + 1);
+    }
+    curPos = std::min(curPos, cut);
+    firstPos = std::min(firstPos, cut);
+    selStart = std::min(selStart, cut);
+    selEnd = std::min(selEnd, cut);
+    selAnchor = std::min(selAnchor, cut);
+    scrollToCursor();
+    Application::invalidate(this);
+    textChanged();
+}
+
+void TextBox::setValidator(std::unique_ptr<Validator> value) {
+    validator = std::move(value);
+    validatorStates.clear();
+    newValidatorStates.clear();
+    if (validator) {
+        int32_t length = buffer.getLength();
+        validatorStates.reserve(length + 1);
+        Validator::State state = validator->start();
+        validatorStates.push_back(state);
+        for (int32_t i = 0; i < length; i++) {
+            state = validator->step(state, static_cast<unsigned char>(buffer.at(i)));
+            validatorStates.push_back(state);
+        }
+    } else {
+        validatorStates.shrink_to_fit();
+        newValidatorStates.shrink_to_fit();
+    }
+}
+
+bool TextBox::isInputValid() const {
+    return !validator || validator->isComplete(validatorStates.back());
+}
+
+int32_t TextBox::nextChar(int32_t position) const {
+    return graphemes.getByteOffset(std::min(graphemes.findByte(position) + 1, graphemes.getCount()));
+}
+
+int32_t TextBox::prevChar(int32_t position) const {
+    int32_t index = graphemes.findByte(position);
+    if (graphemes.getByteOffset(index) == position && index > 0) {
+        index--;
+    }
+    return graphemes.getByteOffset(index);
+}
+
+int32_t TextBox::nextWord(int32_t position) const {
+    // As TInputLine: skip the rest of this word, then the spaces after it.
+    int32_t length = buffer.getLength();
+    while (position < length && buffer.at(position) != ' ') {
+        position++;
+    }
+    while (position < length && buffer.at(position) == ' ') {
+        position++;
+    }
+    return position;
+}
+
+int32_t TextBox::prevWord(int32_t position) const {
+    while (position > 0 && buffer.at(position - 1) == ' ') {
+        position--;
+    }
+    while (position > 0 && buffer.at(position - 1) != ' ') {
+        position--;
+    }
+    return position;
+}
+
+int32_t TextBox::columnOf(int32_t position) const {
+    return graphemes.getColumn(graphemes.findByte(position));
+}
+
+int32_t TextBox::positionAt(int32_t column) const {
+    // Column 0 is the left arrow; pointing at it or further left moves one character back into the hidden text.
+    if (column < 1) {
+        return prevChar(firstPos);
+    }
+    return graphemes.getByteOffset(graphemes.findColumn(columnOf(firstPos) + column - 1));
+}
+
+void TextBox::moveCursor(int32_t position, bool extend) {
+    if (extend) {
+        if (selStart == selEnd) {
+            selAnchor = curPos;
+        }
+        curPos = position;
+        selStart = std::min(selAnchor, curPos);
+        selEnd = std::max(selAnchor, curPos);
+    } else {
+        curPos = position;
+        selStart = selEnd = 0;
+    }
+}
+
+void TextBox::scrollToCursor() {
+    // The first position shown is the first cluster that starts no more than a screen width left of the cursor.
+    int32_t columns = std::max(0, size.x - 2);
+    if (curPos < firstPos) {
+        firstPos = curPos;
+        return;
+    }
+    int32_t cursorColumn = columnOf(curPos);
+    if (cursorColumn - columnOf(firstPos) > columns) {
+        int32_t index = graphemes.findColumn(cursorColumn - columns);
+        if (graphemes.getColumn(index) < cursorColumn - columns) {
+            index++;
+        }
+        firstPos = graphemes.getByteOffset(index);
+    }
+}
+
+void TextBox::selectAll(bool enable) {
+    selStart = 0;
+    selEnd = enable ? buffer.getLength() : 0;
+    selAnchor = 0;
+    curPos = selEnd;
+    scrollToCursor();
+    Application::invalidate(this);
+}
+
+void TextBox::copySelection() {
+    if (selStart != selEnd) {
+        std::string text(selEnd - selStart, '\0');
+        buffer.copy(selStart, selEnd - selStart, &text[0]);
+        TClipboard::setText(TStringView(text.data(), text.size()));
+    }
+}
+
+bool TextBox::recallHistory(int32_t step) {
+    // Up goes back through the entries that start with the text as it was before the first recall, and Down comes
+    // forward again to that text. An edit since the last recall starts over from the new text.
+    if (historyGeneration != editGeneration) {
+        historyPrefix = buffer.c_str();
+        historyIndex = -1;
+    }
+    int32_t target = historyIndex + step;
+    if (target < -1) {
+        return false;
+    }
+    const char* text = historyPrefix.data();
+    int32_t textLength = static_cast<int32_t>(historyPrefix.size());
+    if (target >= 0) {
+        std::vector<int32_t> found(target + 1);
+        int32_t prefixLength = static_cast<int32_t>(historyPrefix.size());
+        if (history.findPrefix(historyPrefix.data(), prefixLength, found.data(), target + 1) <= target) {
+            return false;
+        }
+        text = history.at(found[target]);
+        textLength = history.lengthAt(found[target]);
+    }
+    historyIndex = target;
+    bool changed = replace(0, buffer.getLength(), text, textLength, false);
+
+    // The caller is about to call textChanged(), which moves the generation on.
+    historyGeneration = editGeneration + (changed ? 1 : 0);
+    return changed;
+}
+
+History& TextBox::getHistory() {
+    return history;
+}
+
+SuggestionPipeline& TextBox::getSuggestions() {
+    return suggestions;
+}
+
+bool TextBox::applySuggestions(ListBox* list) {
+    std::string data;
+    std::vector<int32_t> offsets;
+    if (!suggestions.take(&data, &offsets) || list == nullptr || list->getVirtualMode()) {
+        return false;
+    }
+    int32_t count = static_cast<int32_t>(offsets.size()) - 1;
+    if (!list->canAddItems(offsets.data(), count, true)) {
+        return false;
+    }
+    list->replaceItems(data.data(), offsets.data(), count);
+    return true;
 }
 
 int32_t TextBox::clampIndex(int32_t index) const {
-    int32_t textLen = static_cast<int32_t>(strlen(data));
-    return std::max(0, std::min(index, textLen));
+    return std::max(0, std::min(index, graphemes.getCount()));
 }
 
 int32_t TextBox::getSelectionStart() const {
-    // TInputLine may have selStart > selEnd after certain operations.
-    // Normalize to the smaller value.
-    return std::min(selStart, selEnd);
+    return graphemes.findByte(selStart);
 }
 
 void TextBox::setSelectionStart(int32_t value) {
@@ -78,7 +551,7 @@ void TextBox::setSelectionStart(int32_t value) {
 }
 
 int32_t TextBox::getSelectionLength() const {
-    return std::abs(selEnd - selStart);
+    return graphemes.findByte(selEnd) - graphemes.findByte(selStart);
 }
 
 void TextBox::setSelectionLength(int32_t value) {
@@ -87,20 +560,20 @@ void TextBox::setSelectionLength(int32_t value) {
     selectRange(start, length);
 }
 
+int32_t TextBox::getSelectedTextLength() const {
+    return selEnd - selStart;
+}
+
 void TextBox::getSelectedText(char* buffer, int32_t bufferSize) const {
     if (!buffer || bufferSize <= 0)
         return;
 
-    int32_t start = getSelectionStart();
-    int32_t length = getSelectionLength();
-
-    if (length == 0 || !data) {
-        buffer[0] = '\0';
-        return;
+    // A buffer too small for the whole selection gets whole characters only.
+    int32_t copyLen = std::min(selEnd - selStart, bufferSize - 1);
+    while (copyLen > 0 && copyLen < selEnd - selStart && isContinuationByte(this->buffer.at(selStart + copyLen))) {
+        copyLen--;
     }
-
-    int32_t copyLen = std::min(length, bufferSize - 1);
-    strncpy(buffer, data + start, copyLen);
+    this->buffer.copy(selStart, copyLen, buffer);
     buffer[copyLen] = '\0';
 }
 
@@ -108,59 +581,46 @@ void TextBox::setSelectedText(const char* text) {
     if (!text)
         text = "";
 
-    int32_t start = getSelectionStart();
-    int32_t length = getSelectionLength();
+    // Replacing the selection with the same text, or nothing with nothing, leaves the text as it was.
+    bool changed = replace(selStart, selEnd - selStart, text, static_cast<int32_t>(strlen(text)), false);
 
-    // Delete current selection
-    if (length > 0) {
-        int32_t textLen = static_cast<int32_t>(strlen(data));
-        memmove(data + start, data + start + length, textLen - start - length + 1);
-    }
+    Application::invalidate(this);
 
-    // Insert new text at selection start
-    int32_t insertLen = static_cast<int32_t>(strlen(text));
-    int32_t currentLen = static_cast<int32_t>(strlen(data));
-    int32_t available = maxLen - currentLen;
-    insertLen = std::min(insertLen, available);
-
-    if (insertLen > 0) {
-        memmove(data + start + insertLen, data + start, currentLen - start + 1);
-        memcpy(data + start, text, insertLen);
-    }
-
-    // Position cursor after inserted text
-    curPos = start + insertLen;
-    selStart = selEnd = 0;
-
-    drawView();
-
-    // Fire TextChanged
-    if (previousText != data) {
-        previousText = data;
-        textChangedEventHandler();
+    if (changed) {
+        textChanged();
     }
 }
 
 void TextBox::selectRange(int32_t start, int32_t length) {
     int32_t clampedStart = clampIndex(start);
-    int32_t textLen = static_cast<int32_t>(strlen(data));
-    int32_t clampedLength = std::max(0, std::min(length, textLen - clampedStart));
+    int32_t clampedLength = std::max(0, std::min(length, graphemes.getCount() - clampedStart));
 
-    selStart = clampedStart;
-    selEnd = clampedStart + clampedLength;
+    selStart = graphemes.getByteOffset(clampedStart);
+    selEnd = graphemes.getByteOffset(clampedStart + clampedLength);
+    selAnchor = selStart;
     curPos = selEnd;
 
-    drawView();
+    scrollToCursor();
+    Application::invalidate(this);
 }
 
 void TextBox::selectAllText() {
-    selectAll(True);
+    selectAll(true);
 }
 
 void TextBox::clearText() {
     setText("");
 }
 
+void TextBox::paste(const char* text, int32_t length) {
+    bool changed = insertText(text, length);
+    scrollToCursor();
+    Application::invalidate(this);
+    if (changed) {
+        textChanged();
+    }
+}
+
 }  // namespace tf
 
 TF_DEFAULT_CONSTRUCTOR(TextBox)
@@ -187,7 +647,15 @@ TF_EXPORT tf::Error TfTextBoxSetText(tf::TextBox* self, const char* text) {
     return tf::Success;
 }
 
-// MaxLength property (readonly)
+TF_EXPORT tf::Error TfTextBoxGetEditGeneration(tf::TextBox* self, uint64_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getEditGeneration();
+    return tf::Success;
+}
+
+// MaxLength property
 TF_EXPORT tf::Error TfTextBoxGetMaxLength(tf::TextBox* self, int32_t* out) {
     if (self == nullptr || out == nullptr) {
         return tf::Error_ArgumentNull;
@@ -196,6 +664,213 @@ TF_EXPORT tf::Error TfTextBoxGetMaxLength(tf::TextBox* self, int32_t* out) {
     return tf::Success;
 }
 
+TF_EXPORT tf::Error TfTextBoxSetMaxLength(tf::TextBox* self, int32_t value) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (value < 0) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setMaxLength(value);
+    return tf::Success;
+}
+
+// Validator property
+TF_EXPORT tf::Error TfTextBoxSetPatternValidator(tf::TextBox* self, const char* pattern) {
+    if (self == nullptr || pattern == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    std::string error;
+    std::unique_ptr<tf::PatternValidator> validator;
+    try {
+        validator = tf::PatternValidator::compile(pattern, &error);
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    }
+    if (!validator) {
+        tf::setLastErrorMessage(error);
+        return static_cast<tf::Error>(tf::Error_InvalidArgument | tf::Error_HasMessage);
+    }
+    self->setValidator(std::move(validator));
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxSetRangeValidator(tf::TextBox* self, int64_t minimum, int64_t maximum) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (minimum > maximum) {
+        return tf::Error_InvalidArgument;
+    }
+    self->setValidator(std::unique_ptr<tf::Validator>(new tf::RangeValidator(minimum, maximum)));
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxClearValidator(tf::TextBox* self) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setValidator(nullptr);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxGetInputValid(tf::TextBox* self, BOOL* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->isInputValid() ? TRUE : FALSE;
+    return tf::Success;
+}
+
+// History
+TF_EXPORT tf::Error TfTextBoxGetHistoryCapacity(tf::TextBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getHistory().getCapacity();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxSetHistoryCapacity(tf::TextBox* self, int32_t value) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (value < 0) {
+        return tf::Error_InvalidArgument;
+    }
+    try {
+        self->getHistory().setCapacity(value);
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxGetHistoryCount(tf::TextBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getHistory().getCount();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxGetHistoryItem(tf::TextBox* self, int32_t index, const char** out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (index < 0 || index >= self->getHistory().getCount()) {
+        return tf::Error_InvalidArgument;
+    }
+    *out = TF_STRDUP(self->getHistory().at(index));
+    if (*out == nullptr) {
+        return tf::Error_OutOfMemory;
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxAddHistory(tf::TextBox* self, const char* text) {
+    if (self == nullptr || text == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->getHistory().add(text, static_cast<int32_t>(strlen(text)));
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxClearHistory(tf::TextBox* self) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->getHistory().clear();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxFindHistory(
+    tf::TextBox* self,
+    const char* prefix,
+    int32_t* indexes,
+    int32_t maxCount,
+    int32_t* count) {
+    if (self == nullptr || prefix == nullptr || indexes == nullptr || count == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (maxCount < 0) {
+        return tf::Error_InvalidArgument;
+    }
+    *count = self->getHistory().findPrefix(prefix, static_cast<int32_t>(strlen(prefix)), indexes, maxCount);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxOpenHistoryFile(tf::TextBox* self, const char* path) {
+    if (self == nullptr || path == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    std::string error;
+    if (!self->getHistory().openFile(path, &error)) {
+        tf::setLastErrorMessage(error);
+        return static_cast<tf::Error>(tf::Error_InvalidArgument | tf::Error_HasMessage);
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxCloseHistoryFile(tf::TextBox* self) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->getHistory().closeFile();
+    return tf::Success;
+}
+
+// Suggestions
+TF_EXPORT tf::Error TfTextBoxSetSuggestionProvider(tf::TextBox* self, tf::SuggestionFunction function, void* userData) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->getSuggestions().setProvider(function, userData);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxSetSuggestionsReadyEventHandler(
+    tf::TextBox* self,
+    tf::EventHandlerFunction function,
+    void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->getSuggestions().setReadyEventHandler(function, userData);
+    return tf::Success;
+}
+
+// May be called from any thread.
+TF_EXPORT tf::Error TfTextBoxSubmitSuggestions(
+    tf::TextBox* self,
+    uint64_t generation,
+    const char* data,
+    const int32_t* offsets,
+    int32_t count,
+    BOOL* accepted) {
+    if (self == nullptr || accepted == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    tf::Error error = tf::checkPackedItems(data, offsets, count);
+    if (error != tf::Success) {
+        return error;
+    }
+    try {
+        *accepted = self->getSuggestions().submit(generation, data, offsets, count) ? TRUE : FALSE;
+    } catch (const std::bad_alloc&) {
+        return tf::Error_OutOfMemory;
+    }
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTextBoxApplySuggestions(tf::TextBox* self, tf::ListBox* list, BOOL* applied) {
+    if (self == nullptr || applied == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *applied = self->applySuggestions(list) ? TRUE : FALSE;
+    return tf::Success;
+}
+
 // Selection properties
 TF_EXPORT tf::Error TfTextBoxGetSelectionStart(tf::TextBox* self, int32_t* out) {
     if (self == nullptr || out == nullptr) {
@@ -241,6 +916,14 @@ TF_EXPORT tf::Error TfTextBoxGetSelectedText(tf::TextBox* self, char* buffer, in
     return tf::Success;
 }
 
+TF_EXPORT tf::Error TfTextBoxGetSelectedTextLength(tf::TextBox* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    *out = self->getSelectedTextLength();
+    return tf::Success;
+}
+
 TF_EXPORT tf::Error TfTextBoxSetSelectedText(tf::TextBox* self, const char* text) {
     if (self == nullptr || text == nullptr) {
         return tf::Error_ArgumentNull;
@@ -274,6 +957,14 @@ TF_EXPORT tf::Error TfTextBoxClear(tf::TextBox* self) {
     return tf::Success;
 }
 
+TF_EXPORT tf::Error TfTextBoxPaste(tf::TextBox* self, const char* text) {
+    if (self == nullptr || text == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->paste(text, static_cast<int32_t>(strlen(text)));
+    return tf::Success;
+}
+
 // Event handler setup
 TF_EXPORT tf::Error TfTextBoxSetTextChangedEventHandler(
     tf::TextBox* self,
@@ -285,3 +976,14 @@ TF_EXPORT tf::Error TfTextBoxSetTextChangedEventHandler(
     self->setTextChangedEventHandler(function, userData);
     return tf::Success;
 }
+
+TF_EXPORT tf::Error TfTextBoxSetPasteEventHandler(
+    tf::TextBox* self,
+    tf::TextBoxPasteFunction function,
+    void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    self->setPasteEventHandler(function, userData);
+    return tf::Success;
+}
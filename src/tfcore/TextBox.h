@@ -2,53 +2,157 @@
 
 #include "common.h"
 #include "EventHandler.h"
+#include "GapBuffer.h"
+#include "GraphemeMap.h"
+#include "History.h"
+#include "SuggestionPipeline.h"
+#include "Validator.h"
 
-#define Uses_TInputLine
+#define Uses_TView
 #define Uses_TEvent
+#define Uses_TPalette
 #include <tvision/tv.h>
 
-#include <string>
+#include <memory>
+#include <vector>
 
 namespace tf {
 
-/// Wraps TInputLine for single-line text input with change detection and selection support.
-class TextBox : public TInputLine {
+class ListBox;
+
+// Offered the text of a paste before the TextBox inserts it. Returns TRUE to take the text instead, in which case the
+// TextBox inserts nothing.
+typedef BOOL(TF_CDECL* TextBoxPasteFunction)(void* userData, const char* text, int32_t length);
+
+/// Single-line text input with change detection and selection support.
+///
+/// A port of TInputLine's editing and drawing onto a GapBuffer. TInputLine keeps its text in a fixed array sized when
+/// it is constructed, which caps the length for the life of the control; here the buffer grows as text is added, and
+/// the maximum length is only a limit that can change at any time.
+///
+/// Internally, positions are byte offsets into the UTF-8 text, always on a grapheme cluster boundary so that the cursor
+/// and the selection never split a character. The public selection API counts grapheme clusters instead, converting
+/// through a GraphemeMap that is updated with each edit.
+class TextBox : public TView {
    public:
     TextBox();
 
+    virtual void draw() override;
     virtual void handleEvent(TEvent& event) override;
+    virtual void setState(ushort aState, Boolean enable) override;
+    virtual TPalette& getPalette() const override;
 
     void setTextChangedEventHandler(EventHandlerFunction function, void* userData);
+    void setPasteEventHandler(TextBoxPasteFunction function, void* userData);
 
-    // Text property
-    const char* getText() const;
+    // Bumped once for every change to the text, by the user or through the setters, and never otherwise. Callers can
+    // keep a copy of the text and refetch it only when the generation has moved.
+    uint64_t getEditGeneration() const;
+
+    // Text property. getText() joins the text around the gap, so it is not const.
+    const char* getText();
     void setText(const char* text);
 
-    // MaxLength property (readonly - TInputLine doesn't support dynamic resize)
+    // MaxLength property, in bytes. Lowering it below the current length truncates the text; neither direction
+    // reallocates the buffer.
     int32_t getMaxLength() const;
+    void setMaxLength(int32_t value);
 
-    // Selection properties
+    // Selection properties, in grapheme clusters.
     int32_t getSelectionStart() const;
     void setSelectionStart(int32_t value);
 
     int32_t getSelectionLength() const;
     void setSelectionLength(int32_t value);
 
-    // SelectedText property
+    // SelectedText property. getSelectedTextLength() is in bytes, not counting the terminator.
+    int32_t getSelectedTextLength() const;
     void getSelectedText(char* buffer, int32_t bufferSize) const;
     void setSelectedText(const char* text);
 
-    // Methods
+    // Validator property. Typing, deleting, cutting or pasting that would leave text no continuation could make valid
+    // is refused. Text set through the setters is taken as it is, but while it is invalid the user's edits are only
+    // checked for making it no worse. Null removes the validator.
+    void setValidator(std::unique_ptr<Validator> value);
+
+    // Whether the text is complete according to the validator. Always true without one.
+    bool isInputValid() const;
+
+    // Text entered before. The text is added when the TextBox loses the focus, and Up and Down recall the entries that
+    // start with what had been typed, newest first, as TInputLine does through its THistory button.
+    History& getHistory();
+
+    // Suggestions for the text, looked up on a worker thread after each change; see SuggestionPipeline. The newest
+    // result set can be moved into a ListBox in one update with applySuggestions(), which returns false if there was
+    // none or the ListBox is in virtual mode.
+    SuggestionPipeline& getSuggestions();
+    bool applySuggestions(ListBox* list);
+
+    // Methods. selectRange() counts grapheme clusters.
     void selectRange(int32_t start, int32_t length);
     void selectAllText();
     void clearText();
 
+    // Inserts text in place of the selection as one edit, as a paste from the terminal would be, with line breaks and
+    // other control characters turned into spaces. The validator applies. Does not raise the paste event.
+    void paste(const char* text, int32_t length);
+
    private:
+    // Replaces bytes [start, start + length) with as much of `text` as fits in the maximum length and puts the cursor
+    // after it. Returns whether the text changed; the caller redraws and calls textChanged(). With `validate` set, an
+    // edit the validator refuses changes nothing, not even the cursor.
+    bool replace(int32_t start, int32_t length, const char* text, int32_t textLength, bool validate);
+    void textChanged();
+    bool insertText(const char* text, int32_t length);
+
+    // Cursor movement, as in TInputLine: by grapheme cluster, by word, and to the cluster under a screen column.
+    int32_t nextChar(int32_t position) const;
+    int32_t prevChar(int32_t position) const;
+    int32_t nextWord(int32_t position) const;
+    int32_t prevWord(int32_t position) const;
+    int32_t columnOf(int32_t position) const;
+    int32_t positionAt(int32_t column) const;
+    void moveCursor(int32_t position, bool extend);
+    void scrollToCursor();
+    void selectAll(bool enable);
+    void copySelection();
+    bool recallHistory(int32_t step);
+
+    // Helper: Clamp a cluster index to valid range [0, cluster count]
+    int32_t clampIndex(int32_t index) const;
+
+    GapBuffer buffer;
+    GraphemeMap graphemes;
+    int32_t maxLength{ 256 };
+
+    // The same state TInputLine keeps: the cursor, the first byte shown, and the selection as an ordered byte range.
+    // `selAnchor` is the end of the selection that stays put while Shift extends it.
+    int32_t curPos{ 0 };
+    int32_t firstPos{ 0 };
+    int32_t selStart{ 0 };
+    int32_t selEnd{ 0 };
+    int32_t selAnchor{ 0 };
+
+    // The validator's state after each byte of the text; entry i covers the first i bytes. An edit at byte p resumes
+    // from entry p, so typing at the end of the text reads only the new characters. Empty without a validator.
+    std::unique_ptr<Validator> validator;
+    std::vector<Validator::State> validatorStates;
+    std::vector<Validator::State> newValidatorStates;
+
+    // While the text is one recalled from the history, `historyIndex` is its place among the matches for
+    // `historyPrefix`, or -1 for the typed text itself. Any other edit moves the generation on and ends the recall.
+    History history;
+    std::string historyPrefix;
+    int32_t historyIndex{ -1 };
+    uint64_t historyGeneration{ 0 };
+
     EventHandler textChangedEventHandler{};
-    std::string previousText;
+    TextBoxPasteFunction pasteFunction{ nullptr };
+    void* pasteUserData{ nullptr };
+    uint64_t editGeneration{ 0 };
 
-    // Helper: Clamp index to valid range [0, textLength]
-    int32_t clampIndex(int32_t index) const;
+    // Last, so it is destroyed first: its worker may still be submitting results for this TextBox until it stops.
+    SuggestionPipeline suggestions;
 };
 
 template <>
@@ -0,0 +1,211 @@
+#include "TextMetrics.h"
+
+#define Uses_TText
+#include <tvision/tv.h>
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define TF_TEXT_METRICS_X86 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace tf {
+
+#ifdef TF_TEXT_METRICS_X86
+static inline int32_t countTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int32_t>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+int32_t countAscii(const char* text, int32_t length) {
+    int32_t i = 0;
+#ifdef TF_TEXT_METRICS_X86
+    // The high bit of each byte is exactly what movemask collects.
+    for (; i + 16 <= length; i += 16) {
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i))));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+#endif
+    while (i < length && static_cast<unsigned char>(text[i]) < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+int32_t measureWidth(const char* text, int32_t length) {
+    int32_t ascii = countAscii(text, length);
+    if (ascii == length) {
+        return length;
+    }
+    return ascii + static_cast<int32_t>(TText::width(TStringView(text + ascii, length - ascii)));
+}
+
+int32_t fitWidth(const char* text, int32_t length, int32_t columns) {
+    if (columns <= 0) {
+        return 0;
+    }
+    int32_t ascii = countAscii(text, std::min(length, columns));
+    if (ascii == length || ascii == columns) {
+        return ascii;
+    }
+
+    int32_t i = ascii;
+    int32_t width = ascii;
+    while (i < length) {
+        int32_t next = static_cast<int32_t>(TText::next(TStringView(text + i, length - i)));
+        if (next <= 0) {
+            break;
+        }
+        int32_t charWidth = static_cast<int32_t>(TText::width(TStringView(text + i, next)));
+        if (width + charWidth > columns) {
+            break;
+        }
+        width += charWidth;
+        i += next;
+    }
+    return i;
+}
+
+int32_t decodeUtf8(const char* text, int32_t length, uint32_t* codePoint) {
+    if (length <= 0) {
+        return 0;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text);
+    uint32_t c = bytes[0];
+    int32_t count;
+    uint32_t minimum;
+    if (c < 0x80) {
+        *codePoint = c;
+        return 1;
+    } else if (c >= 0xC2 && c <= 0xDF) {
+        count = 2;
+        minimum = 0x80;
+        c &= 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        count = 3;
+        minimum = 0x800;
+        c &= 0x0F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        count = 4;
+        minimum = 0x10000;
+        c &= 0x07;
+    } else {
+        return 0;
+    }
+    if (count > length) {
+        return 0;
+    }
+    for (int32_t i = 1; i < count; i++) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        c = (c << 6) | (bytes[i] & 0x3F);
+    }
+    if (c < minimum || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+        return 0;
+    }
+    *codePoint = c;
+    return count;
+}
+
+int32_t validUtf8Length(const char* text, int32_t length) {
+    int32_t i = 0;
+    while (true) {
+        i += countAscii(text + i, length - i);
+        if (i == length) {
+            return i;
+        }
+        uint32_t codePoint;
+        int32_t count = decodeUtf8(text + i, length - i, &codePoint);
+        if (count == 0) {
+            return i;
+        }
+        i += count;
+    }
+}
+
+static inline bool isControl(uint32_t c) {
+    return c < 0x20 || (c >= 0x7F && c <= 0x9F) || c == 0x2028 || c == 0x2029;
+}
+
+static inline bool isRegionalIndicator(uint32_t c) {
+    return c >= 0x1F1E6 && c <= 0x1F1FF;
+}
+
+static const uint32_t zeroWidthJoiner = 0x200D;
+
+// Whether the code point, `length` bytes at `text`, attaches to the character before it.
+static bool isExtend(const char* text, int32_t length, uint32_t c) {
+    if (c < 0x300) {
+        return false;
+    }
+    if (c == zeroWidthJoiner || (c >= 0xFE00 && c <= 0xFE0F) || (c >= 0x1F3FB && c <= 0x1F3FF) ||
+        (c >= 0xE0020 && c <= 0xE007F) || (c >= 0xE0100 && c <= 0xE01EF)) {
+        return true;
+    }
+    // Combining marks and the other zero-width characters are whatever Turbo Vision gives no column of its own.
+    return TText::width(TStringView(text, length)) == 0;
+}
+
+int32_t nextGrapheme(const char* text, int32_t length) {
+    if (length <= 0) {
+        return 0;
+    }
+
+    // Nothing attaches to an ASCII character except through a non-ASCII byte, so ASCII followed by ASCII is a cluster
+    // of one byte without decoding anything.
+    unsigned char first = static_cast<unsigned char>(text[0]);
+    if (first < 0x80) {
+        if (first == '\r' && length > 1 && text[1] == '\n') {
+            return 2;
+        }
+        if (length == 1 || static_cast<unsigned char>(text[1]) < 0x80 || isControl(first)) {
+            return 1;
+        }
+    }
+
+    uint32_t c;
+    int32_t i = decodeUtf8(text, length, &c);
+    if (i == 0) {
+        return 1;
+    }
+    if (isControl(c)) {
+        return i;
+    }
+
+    bool afterJoiner = false;
+    bool openFlag = isRegionalIndicator(c);
+    while (i < length) {
+        int32_t count = decodeUtf8(text + i, length - i, &c);
+        if (count == 0 || isControl(c)) {
+            break;
+        }
+        if (isExtend(text + i, count, c)) {
+            afterJoiner = c == zeroWidthJoiner;
+        } else if (afterJoiner) {
+            // Emoji sequences such as family or profession emoji are joined with ZWJ.
+            afterJoiner = false;
+        } else if (openFlag && isRegionalIndicator(c)) {
+            openFlag = false;
+        } else {
+            break;
+        }
+        i += count;
+    }
+    return i;
+}
+
+}  // namespace tf
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "common.h"
+
+namespace tf {
+
+// Display width, in screen columns, of UTF-8 text. Runs of ASCII count one column per byte without decoding; the rest
+// is measured by Turbo Vision, so wide (CJK, emoji) and zero-width characters agree with what it draws.
+int32_t measureWidth(const char* text, int32_t length);
+
+// Returns the length in bytes of the longest prefix of `text` that fits in `columns` screen columns. A wide character
+// that would straddle the edge is left out.
+int32_t fitWidth(const char* text, int32_t length, int32_t columns);
+
+// Length of the leading run of ASCII bytes. Checks 16 bytes at a time where SSE2 is available.
+int32_t countAscii(const char* text, int32_t length);
+
+// Decodes the UTF-8 sequence at the start of `text`. Returns its length in bytes and stores the code point, or returns
+// 0 if the sequence is malformed, overlong, truncated, or encodes a surrogate.
+int32_t decodeUtf8(const char* text, int32_t length, uint32_t* codePoint);
+
+// Length in bytes of the longest prefix of `text` that is well-formed UTF-8. ASCII runs are skipped with countAscii(),
+// so mostly-ASCII text costs little more than a scan for high bits.
+int32_t validUtf8Length(const char* text, int32_t length);
+
+// Length in bytes of the grapheme cluster (user-perceived character) at the start of `text`. This follows the parts of
+// Unicode's extended grapheme cluster rules that matter on a terminal: CR LF stays together, zero-width characters
+// (combining marks, variation selectors), emoji modifiers and whatever follows a zero-width joiner attach to the
+// preceding character, and regional indicators pair up into flags. Malformed bytes are clusters of their own.
+int32_t nextGrapheme(const char* text, int32_t length);
+
+}  // namespace tf
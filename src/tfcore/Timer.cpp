@@ -0,0 +1,89 @@
+#include "Timer.h"
+#include "Application.h"
+
+namespace tf {
+
+Timer::Timer() {}
+
+Timer::~Timer() {
+    Application::instance.getTimerWheel().cancel(&node);
+}
+
+void Timer::setInterval(int32_t value) {
+    node.interval = value;
+    auto& wheel = Application::instance.getTimerWheel();
+    if (wheel.isArmed(&node)) {
+        wheel.start(&node, TimerWheel::now());
+    }
+}
+
+BOOL Timer::getEnabled() const {
+    return Application::instance.getTimerWheel().isArmed(&node) ? TRUE : FALSE;
+}
+
+void Timer::setEnabled(BOOL value) {
+    auto& wheel = Application::instance.getTimerWheel();
+    if (!value) {
+        wheel.cancel(&node);
+    } else if (!wheel.isArmed(&node)) {
+        wheel.start(&node, TimerWheel::now());
+    }
+}
+
+void Timer::setTickEventHandler(EventHandlerFunction function, void* userData) {
+    node.handler = EventHandler(function, userData);
+}
+
+}  // namespace tf
+
+TF_DEFAULT_CONSTRUCTOR(Timer)
+
+TF_BOILERPLATE_FUNCTIONS(Timer)
+
+TF_EXPORT tf::Error TfTimerGetInterval(tf::Timer* self, int32_t* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+
+    *out = self->getInterval();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTimerSetInterval(tf::Timer* self, int32_t value) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+    if (value < 1) {
+        return tf::Error_InvalidArgument;
+    }
+
+    self->setInterval(value);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTimerGetEnabled(tf::Timer* self, BOOL* out) {
+    if (self == nullptr || out == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+
+    *out = self->getEnabled();
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTimerSetEnabled(tf::Timer* self, BOOL value) {
+    if (self == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+
+    self->setEnabled(value);
+    return tf::Success;
+}
+
+TF_EXPORT tf::Error TfTimerSetTickEventHandler(tf::Timer* self, tf::EventHandlerFunction function, void* userData) {
+    if (self == nullptr || function == nullptr) {
+        return tf::Error_ArgumentNull;
+    }
+
+    self->setTickEventHandler(function, userData);
+    return tf::Success;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "common.h"
+#include "EventHandler.h"
+#include "TimerWheel.h"
+
+namespace tf {
+
+// Raises its tick event on the UI thread every `interval` milliseconds while enabled. Scheduled on the Application's
+// TimerWheel, so the event loop sleeps until the next timer is due rather than polling.
+class Timer {
+   public:
+    Timer();
+    ~Timer();
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    int32_t getInterval() const { return node.interval; }
+    // Restarts the countdown if the timer is enabled.
+    void setInterval(int32_t value);
+    BOOL getEnabled() const;
+    void setEnabled(BOOL value);
+    void setTickEventHandler(EventHandlerFunction function, void* userData);
+
+   private:
+    TimerWheel::Node node;
+};
+
+template <>
+struct equals<Timer> {
+    bool operator()(const Timer& self, const Timer& other) const { return &self == &other; }
+};
+
+}  // namespace tf
+
+namespace std {
+template <>
+struct hash<tf::Timer> {
+    std::size_t operator()(const tf::Timer& p) const noexcept {
+        std::size_t x{};
+        tf::combineHash(&p, &x);
+        return x;
+    }
+};
+}  // namespace std
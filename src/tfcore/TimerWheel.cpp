@@ -0,0 +1,198 @@
+#include "TimerWheel.h"
+
+#include <chrono>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace tf {
+
+static inline int32_t countTrailingZeros(uint64_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int32_t>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+TimerWheel::TimerWheel() : current(now()) {
+    for (auto& level : slots) {
+        for (auto& head : level) {
+            head.prev = head.next = &head;
+        }
+    }
+    due.prev = due.next = &due;
+}
+
+uint64_t TimerWheel::now() {
+    auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+void TimerWheel::start(Node* node, uint64_t now) {
+    if (isArmed(node)) {
+        unlink(node);
+    }
+    node->deadline = align(now + node->interval);
+    insert(node);
+}
+
+void TimerWheel::cancel(Node* node) {
+    if (isArmed(node)) {
+        unlink(node);
+    }
+}
+
+int32_t TimerWheel::fire(uint64_t now) {
+    advance(now);
+
+    // Handlers can only arm timers for after `current`, which go into `slots`, so the batch ends.
+    int32_t count = 0;
+    while (due.next != &due) {
+        auto node = static_cast<Node*>(due.next);
+        unlink(node);
+
+        // Keep to the original schedule, unless the loop fell so far behind that the next tick has passed too.
+        uint64_t next = node->deadline + node->interval;
+        if (next <= current) {
+            next = current + node->interval;
+        }
+        node->deadline = align(next);
+        insert(node);
+
+        // The handler may delete the timer, so the node is not touched after this.
+        auto handler = node->handler;
+        handler();
+        count++;
+    }
+    return count;
+}
+
+int32_t TimerWheel::getTimeout(uint64_t now) const {
+    if (due.next != &due) {
+        return 0;
+    }
+    uint64_t tick = nextTick();
+    if (tick == std::numeric_limits<uint64_t>::max()) {
+        return -1;
+    }
+    if (tick <= now) {
+        return 0;
+    }
+    uint64_t timeout = tick - now;
+    return timeout > INT32_MAX ? INT32_MAX : static_cast<int32_t>(timeout);
+}
+
+uint64_t TimerWheel::align(uint64_t deadline) const {
+    if (slack <= 1) {
+        return deadline;
+    }
+    return (deadline + slack - 1) / slack * slack;
+}
+
+void TimerWheel::append(Link* head, Node* node) {
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+void TimerWheel::insert(Node* node) {
+    if (node->deadline <= current) {
+        append(&due, node);
+        node->bucket = dueBucket;
+        return;
+    }
+
+    // The level is the highest group of bits in which the deadline and the current tick differ. In that group the
+    // deadline's slot is after the current tick's, and the groups above are the same, so the slot comes up before the
+    // level wraps around.
+    uint64_t difference = node->deadline ^ current;
+    int32_t level = 0;
+    while (level < levelCount - 1 && (difference >> ((level + 1) * levelBits)) != 0) {
+        level++;
+    }
+    int32_t slot = static_cast<int32_t>((node->deadline >> (level * levelBits)) & (slotCount - 1));
+
+    append(&slots[level][slot], node);
+    occupied[level] |= uint64_t{ 1 } << slot;
+    node->bucket = static_cast<int16_t>(level * slotCount + slot);
+}
+
+void TimerWheel::unlink(Node* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    if (node->bucket < dueBucket) {
+        int32_t level = node->bucket / slotCount;
+        int32_t slot = node->bucket % slotCount;
+        Link* head = &slots[level][slot];
+        if (head->next == head) {
+            occupied[level] &= ~(uint64_t{ 1 } << slot);
+        }
+    }
+    node->prev = node->next = nullptr;
+    node->bucket = -1;
+}
+
+void TimerWheel::advance(uint64_t now) {
+    for (;;) {
+        uint64_t tick = nextTick();
+        if (tick > now) {
+            if (now > current) {
+                current = now;
+            }
+            return;
+        }
+        current = tick;
+
+        // Drop the timers in the slots that start at this tick to lower levels, from the top down, so that they can
+        // drop more than one level.
+        for (int32_t level = levelCount - 1; level >= 0; level--) {
+            int32_t shift = level * levelBits;
+            if (current & ((uint64_t{ 1 } << shift) - 1)) {
+                continue;
+            }
+            int32_t slot = static_cast<int32_t>((current >> shift) & (slotCount - 1));
+            if (!(occupied[level] & (uint64_t{ 1 } << slot))) {
+                continue;
+            }
+
+            Link* head = &slots[level][slot];
+            Link* link = head->next;
+            head->prev = head->next = head;
+            occupied[level] &= ~(uint64_t{ 1 } << slot);
+            while (link != head) {
+                Link* next = link->next;
+                insert(static_cast<Node*>(link));
+                link = next;
+            }
+        }
+    }
+}
+
+uint64_t TimerWheel::nextTick() const {
+    uint64_t result = std::numeric_limits<uint64_t>::max();
+    for (int32_t level = 0; level < levelCount; level++) {
+        if (!occupied[level]) {
+            continue;
+        }
+        int32_t shift = level * levelBits;
+        int32_t index = static_cast<int32_t>((current >> shift) & (slotCount - 1));
+        uint64_t later = index == slotCount - 1 ? 0 : occupied[level] & (~uint64_t{ 0 } << (index + 1));
+        if (!later) {
+            continue;
+        }
+        uint64_t group = (current >> shift) >> levelBits;
+        uint64_t tick = ((group << levelBits) | static_cast<uint64_t>(countTrailingZeros(later))) << shift;
+        if (tick < result) {
+            result = tick;
+        }
+    }
+    return result;
+}
+
+}  // namespace tf
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "common.h"
+#include "EventHandler.h"
+
+namespace tf {
+
+// Schedules the Application's timers. UI thread only.
+//
+// A hierarchical timing wheel with millisecond ticks: eight levels of 64 slots, where a slot on level L spans 64^L
+// ticks. A timer goes into the lowest level whose span still tells its deadline apart from the current tick, so
+// arming and cancelling is one list insertion or removal, whatever the number of timers. When the current tick reaches
+// the start of a slot on a higher level, that slot's timers drop to lower levels, and those in the level-0 slot for the
+// tick are due.
+//
+// A bitmap per level marks the slots that hold timers, so the wheel can jump straight to the next tick that has work
+// instead of stepping through every millisecond, and getTimeout() tells the event loop how long it may sleep.
+//
+// Deadlines are rounded up to a multiple of the slack, so timers that fall due close together fire in one batch on one
+// wake-up. A timer fires late by less than the slack, and never early.
+class TimerWheel {
+   public:
+    struct Link {
+        Link* prev{ nullptr };
+        Link* next{ nullptr };
+    };
+
+    // A timer as the wheel sees it. Timers repeat every `interval` milliseconds until cancelled.
+    struct Node : Link {
+        uint64_t deadline{ 0 };
+        int32_t interval{ 100 };
+        int16_t bucket{ -1 };
+        EventHandler handler{};
+    };
+
+    TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Milliseconds on the monotonic clock that all the `now` arguments use.
+    static uint64_t now();
+
+    // Arms `node` to fire `node->interval` milliseconds after `now`, replacing its deadline if it is already armed.
+    void start(Node* node, uint64_t now);
+    void cancel(Node* node);
+    bool isArmed(const Node* node) const { return node->bucket >= 0; }
+
+    // Milliseconds that deadlines are rounded up to. 1 keeps them exact; the default is 10, about the resolution of a
+    // Windows timer.
+    int32_t getSlack() const { return slack; }
+    void setSlack(int32_t value) { slack = value; }
+
+    // Runs, as one batch, the handlers of the timers that are due at `now`, and returns how many ran. A handler may
+    // start and cancel timers, including its own and those later in the batch.
+    int32_t fire(uint64_t now);
+
+    // Milliseconds from `now` until fire() next has work, or -1 if no timer is armed.
+    int32_t getTimeout(uint64_t now) const;
+
+   private:
+    static const int32_t levelBits = 6;
+    static const int32_t slotCount = 1 << levelBits;
+    static const int32_t levelCount = 8;
+    static const int16_t dueBucket = levelCount * slotCount;
+
+    uint64_t align(uint64_t deadline) const;
+    void append(Link* head, Node* node);
+    void insert(Node* node);
+    void unlink(Node* node);
+    void advance(uint64_t now);
+    uint64_t nextTick() const;
+
+    Link slots[levelCount][slotCount];
+    uint64_t occupied[levelCount]{};
+
+    // Timers whose deadline has passed, in deadline order, waiting for fire() to run them.
+    Link due;
+
+    // The last tick advance() reached. Every timer in `slots` is due after it.
+    uint64_t current{ 0 };
+    int32_t slack{ 10 };
+};
+
+}  // namespace tf
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "common.h"
+
+namespace tf {
+
+// Checks the text of a TextBox as it is typed. A validator is an automaton over the bytes of the text: start() is the
+// state for empty text and step() reads one more byte. Because a state sums up everything before it, TextBox keeps
+// the state after each byte and, on an edit, resumes from the state where the edit starts.
+class Validator {
+   public:
+    // Pattern validators use only `value`, as a DFA state number; the range validator needs the flags too.
+    struct State {
+        uint64_t value;
+        uint32_t flags;
+
+        bool operator==(const State& other) const { return value == other.value && flags == other.flags; }
+        bool operator!=(const State& other) const { return !(*this == other); }
+    };
+
+    virtual ~Validator() {}
+
+    virtual State start() const = 0;
+    virtual State step(State state, unsigned char c) const = 0;
+
+    // Whether more text could still make the text read so far complete. TextBox rejects edits that make this false.
+    virtual bool isLive(State state) const = 0;
+
+    // Whether the text read so far is complete and valid as it is.
+    virtual bool isComplete(State state) const = 0;
+};
+
+}  // namespace tf
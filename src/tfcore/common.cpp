@@ -15,6 +15,27 @@ void setLastErrorMessage(const std::string& message) {
     lastErrorMessage = message;
 }
 
+Error checkPackedItems(const char* data, const int32_t* offsets, int32_t count) {
+    if (count < 0) {
+        return Error_InvalidArgument;
+    }
+    if (count == 0) {
+        return Success;
+    }
+    if (data == nullptr || offsets == nullptr) {
+        return Error_ArgumentNull;
+    }
+    if (offsets[0] < 0) {
+        return Error_InvalidArgument;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        if (offsets[i + 1] < offsets[i]) {
+            return Error_InvalidArgument;
+        }
+    }
+    return Success;
+}
+
 }  // namespace tf
 
 TF_EXPORT tf::Error TfGetLastErrorMessage(const char** out) {
@@ -39,6 +39,10 @@ enum Error {
 // Thread-local storage for detailed error messages
 void setLastErrorMessage(const std::string& message);
 
+// Validates items passed as one buffer of UTF-8 text plus `count + 1` ascending byte offsets into it, the form the
+// bulk-loading functions take.
+Error checkPackedItems(const char* data, const int32_t* offsets, int32_t count);
+
 // This is a policy for comparing two objects of type `T`.
 // It is used by checkedEquals to compare two objects.
 // It assumes that &self != nullptr && &other != nullptr.